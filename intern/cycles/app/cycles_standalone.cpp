@@ -54,6 +54,7 @@ struct Options {
   bool quiet;
   bool show_help, interactive, pause;
   string output_path;
+  string cache_path;
 } options;
 
 static void session_print(const string &str)
@@ -129,7 +130,7 @@ static void scene_init()
   options.scene = new Scene(options.scene_params, options.session->device);
 
   /* Read XML */
-  xml_read_file(options.scene, options.filepath.c_str());
+  xml_read_file(options.scene, options.filepath.c_str(), options.cache_path);
 
   /* Camera width/height override? */
   if (!(options.width == 0 || options.height == 0)) {
@@ -417,6 +418,9 @@ static void options_parse(int argc, const char **argv)
              "--output %s",
              &options.output_path,
              "File path to write output image",
+             "--cache-dir %s",
+             &options.cache_path,
+             "Directory to cache parsed meshes in, to speed up reading the same scene again",
              "--threads %d",
              &options.session_params.threads,
              "CPU Rendering Threads",
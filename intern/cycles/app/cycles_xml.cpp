@@ -39,6 +39,8 @@
 #include "subd/subd_split.h"
 
 #include "util/util_foreach.h"
+#include "util/util_logging.h"
+#include "util/util_md5.h"
 #include "util/util_path.h"
 #include "util/util_projection.h"
 #include "util/util_transform.h"
@@ -56,6 +58,8 @@ struct XMLReadState : public XMLReader {
   bool smooth;       /* smooth normal state */
   Shader *shader;    /* current shader */
   string base;       /* base path to current file*/
+  string filepath;   /* path to current file */
+  string cache_path; /* directory for cached mesh data, empty if disabled */
   float dicing_rate; /* current dicing rate */
 
   XMLReadState() : scene(NULL), smooth(false), shader(NULL), dicing_rate(1.0f)
@@ -376,6 +380,150 @@ static void xml_read_background(XMLReadState &state, xml_node node)
 
 /* Mesh */
 
+/* Mesh Cache
+ *
+ * Parsing the vertex and polygon arrays of large meshes from XML text dominates the time it
+ * takes to read a scene. The parsed arrays are stored in binary files in the cache directory,
+ * keyed by the file, its size and modification time and the position of the mesh in the file,
+ * so that reading the same scene again skips the parsing. */
+
+#define XML_MESH_CACHE_MAGIC 0x4d584359
+#define XML_MESH_CACHE_VERSION 1
+
+struct XMLMeshArrays {
+  vector<float3> P;
+  vector<float> UV;
+  vector<int> verts, nverts;
+  bool has_UV;
+
+  XMLMeshArrays() : has_UV(false)
+  {
+  }
+};
+
+static string xml_mesh_cache_filepath(const XMLReadState &state, xml_node node)
+{
+  if (state.cache_path.empty()) {
+    return "";
+  }
+
+  MD5Hash md5;
+  md5.append(string_printf("%s %d %zu %llu",
+                           state.filepath.c_str(),
+                           XML_MESH_CACHE_VERSION,
+                           path_file_size(state.filepath),
+                           (unsigned long long)path_modified_time(state.filepath)));
+
+  const ptrdiff_t offset = node.offset_debug();
+  if (offset >= 0) {
+    md5.append(string_printf(" %lld", (long long)offset));
+  }
+  else {
+    /* Offsets are unknown when the parser was built without them, identify the mesh by its
+     * attributes instead. Strings are hashed with their terminator to keep them apart. */
+    for (xml_attribute attr = node.first_attribute(); attr; attr = attr.next_attribute()) {
+      md5.append((const uint8_t *)attr.name(), strlen(attr.name()) + 1);
+      md5.append((const uint8_t *)attr.value(), strlen(attr.value()) + 1);
+    }
+  }
+
+  return path_join(state.cache_path, md5.get_hex() + ".bin");
+}
+
+template<typename T>
+static void xml_mesh_cache_write_array(vector<uint8_t> &binary, const vector<T> &array)
+{
+  const uint64_t size = array.size();
+  const uint8_t *data = (const uint8_t *)&size;
+  binary.insert(binary.end(), data, data + sizeof(size));
+
+  data = (const uint8_t *)array.data();
+  binary.insert(binary.end(), data, data + sizeof(T) * size);
+}
+
+template<typename T>
+static bool xml_mesh_cache_read_array(const vector<uint8_t> &binary,
+                                      size_t &offset,
+                                      vector<T> &array)
+{
+  uint64_t size;
+  if (offset + sizeof(size) > binary.size()) {
+    return false;
+  }
+  memcpy(&size, binary.data() + offset, sizeof(size));
+  offset += sizeof(size);
+
+  if (size > (binary.size() - offset) / sizeof(T)) {
+    return false;
+  }
+  array.resize(size);
+  memcpy(array.data(), binary.data() + offset, sizeof(T) * size);
+  offset += sizeof(T) * size;
+
+  return true;
+}
+
+static bool xml_mesh_cache_read(const string &filepath, XMLMeshArrays &arrays)
+{
+  vector<uint8_t> binary;
+  if (!path_read_binary(filepath, binary)) {
+    return false;
+  }
+
+  vector<int> header;
+  size_t offset = 0;
+  if (!xml_mesh_cache_read_array(binary, offset, header) || header.size() != 3 ||
+      header[0] != XML_MESH_CACHE_MAGIC || header[1] != XML_MESH_CACHE_VERSION) {
+    return false;
+  }
+
+  arrays.has_UV = (header[2] != 0);
+
+  return xml_mesh_cache_read_array(binary, offset, arrays.P) &&
+         xml_mesh_cache_read_array(binary, offset, arrays.UV) &&
+         xml_mesh_cache_read_array(binary, offset, arrays.verts) &&
+         xml_mesh_cache_read_array(binary, offset, arrays.nverts) && offset == binary.size();
+}
+
+static void xml_mesh_cache_write(const string &filepath, const XMLMeshArrays &arrays)
+{
+  vector<int> header;
+  header.push_back(XML_MESH_CACHE_MAGIC);
+  header.push_back(XML_MESH_CACHE_VERSION);
+  header.push_back(arrays.has_UV);
+
+  vector<uint8_t> binary;
+  xml_mesh_cache_write_array(binary, header);
+  xml_mesh_cache_write_array(binary, arrays.P);
+  xml_mesh_cache_write_array(binary, arrays.UV);
+  xml_mesh_cache_write_array(binary, arrays.verts);
+  xml_mesh_cache_write_array(binary, arrays.nverts);
+
+  if (!path_write_binary(filepath, binary)) {
+    fprintf(stderr, "Failed to write mesh cache file %s.\n", filepath.c_str());
+  }
+}
+
+static void xml_read_mesh_arrays(const XMLReadState &state, xml_node node, XMLMeshArrays &arrays)
+{
+  const string cache_filepath = xml_mesh_cache_filepath(state, node);
+
+  if (!cache_filepath.empty() && xml_mesh_cache_read(cache_filepath, arrays)) {
+    VLOG(2) << "Read mesh from cache file " << cache_filepath;
+    return;
+  }
+
+  arrays = XMLMeshArrays();
+  xml_read_float3_array(arrays.P, node, "P");
+  xml_read_int_array(arrays.verts, node, "verts");
+  xml_read_int_array(arrays.nverts, node, "nverts");
+  arrays.has_UV = xml_read_float_array(arrays.UV, node, "UV");
+
+  if (!cache_filepath.empty()) {
+    xml_mesh_cache_write(cache_filepath, arrays);
+  }
+}
+
 static Mesh *xml_add_mesh(Scene *scene, const Transform &tfm)
 {
   /* create mesh */
@@ -402,13 +550,13 @@ static void xml_read_mesh(const XMLReadState &state, xml_node node)
   bool smooth = state.smooth;
 
   /* read vertices and polygons */
-  vector<float3> P;
-  vector<float> UV;
-  vector<int> verts, nverts;
+  XMLMeshArrays arrays;
+  xml_read_mesh_arrays(state, node, arrays);
 
-  xml_read_float3_array(P, node, "P");
-  xml_read_int_array(verts, node, "verts");
-  xml_read_int_array(nverts, node, "nverts");
+  const vector<float3> &P = arrays.P;
+  const vector<float> &UV = arrays.UV;
+  vector<int> &verts = arrays.verts;
+  const vector<int> &nverts = arrays.nverts;
 
   if (xml_equal_string(node, "subdivision", "catmull-clark")) {
     mesh->subdivision_type = Mesh::SUBDIVISION_CATMULL_CLARK;
@@ -445,7 +593,7 @@ static void xml_read_mesh(const XMLReadState &state, xml_node node)
       index_offset += nverts[i];
     }
 
-    if (xml_read_float_array(UV, node, "UV")) {
+    if (arrays.has_UV) {
       ustring name = ustring("UVMap");
       Attribute *attr = mesh->attributes.add(ATTR_STD_UV, name);
       float2 *fdata = attr->data_float2();
@@ -493,7 +641,7 @@ static void xml_read_mesh(const XMLReadState &state, xml_node node)
     }
 
     /* uv map */
-    if (xml_read_float_array(UV, node, "UV")) {
+    if (arrays.has_UV) {
       ustring name = ustring("UVMap");
       Attribute *attr = mesh->subd_attributes.add(ATTR_STD_UV, name);
       float3 *fdata = attr->data_float3();
@@ -672,6 +820,7 @@ static void xml_read_include(XMLReadState &state, const string &src)
   if (parse_result) {
     XMLReadState substate = state;
     substate.base = path_dirname(path);
+    substate.filepath = path;
 
     xml_node cycles = doc.child("cycles");
     xml_read_scene(substate, cycles);
@@ -684,7 +833,7 @@ static void xml_read_include(XMLReadState &state, const string &src)
 
 /* File */
 
-void xml_read_file(Scene *scene, const char *filepath)
+void xml_read_file(Scene *scene, const char *filepath, const string &cache_path)
 {
   XMLReadState state;
 
@@ -694,6 +843,7 @@ void xml_read_file(Scene *scene, const char *filepath)
   state.smooth = false;
   state.dicing_rate = 1.0f;
   state.base = path_dirname(filepath);
+  state.cache_path = cache_path;
 
   xml_read_include(state, path_filename(filepath));
 
@@ -17,11 +17,15 @@
 #ifndef __CYCLES_XML_H__
 #define __CYCLES_XML_H__
 
+#include "util/util_string.h"
+
 CCL_NAMESPACE_BEGIN
 
 class Scene;
 
-void xml_read_file(Scene *scene, const char *filepath);
+/* Read scene from XML file. If cache_path is not empty, parsed mesh data is cached in that
+ * directory and reused when reading the same file again. */
+void xml_read_file(Scene *scene, const char *filepath, const string &cache_path = "");
 
 /* macros for importing */
 #define RAD2DEGF(_rad) ((_rad) * (float)(180.0 / M_PI))
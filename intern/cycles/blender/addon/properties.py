@@ -702,6 +702,14 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         "but time can be saved by manually stopping the render when the noise is low enough)",
         default=False,
     )
+    checkpoint_directory: StringProperty(
+        name="Checkpoint Directory",
+        description="Directory where finished tiles of final renders are stored, "
+        "so that an interrupted render resumes from them instead of starting over "
+        "(clear the directory after changing the scene)",
+        subtype='DIR_PATH',
+        default="",
+    )
 
     bake_type: EnumProperty(
         name="Bake Type",
@@ -826,6 +834,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default='EMBREE',
     )
     debug_use_cpu_split_kernel: BoolProperty(name="Split Kernel", default=False)
+    debug_use_cpu_deterministic: BoolProperty(
+        name="Deterministic",
+        description="Render identical results on any machine and with any number of threads, "
+        "at the cost of performance",
+        default=False,
+    )
 
     debug_use_cuda_adaptive_compile: BoolProperty(name="Adaptive Compile", default=False)
     debug_use_cuda_split_kernel: BoolProperty(name="Split Kernel", default=False)
@@ -690,6 +690,10 @@ class CYCLES_RENDER_PT_performance_tiles(CyclesButtonsPanel, Panel):
         sub.active = not rd.use_save_buffers
         sub.prop(cscene, "use_progressive_refine")
 
+        sub = col.column()
+        sub.active = not cscene.use_progressive_refine
+        sub.prop(cscene, "checkpoint_directory")
+
 
 class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Panel):
     bl_label = "Acceleration Structure"
@@ -2017,6 +2021,7 @@ class CYCLES_RENDER_PT_debug(CyclesButtonsPanel, Panel):
         row.prop(cscene, "debug_use_cpu_avx2", toggle=True)
         col.prop(cscene, "debug_bvh_layout")
         col.prop(cscene, "debug_use_cpu_split_kernel")
+        col.prop(cscene, "debug_use_cpu_deterministic")
 
         col.separator()
 
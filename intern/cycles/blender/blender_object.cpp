@@ -152,32 +152,81 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     return NULL;
   }
 
-  /* Visibility flags for both parent and child. */
-  PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
-  bool use_holdout = get_boolean(cobject, "is_holdout") ||
-                     b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
-  uint visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
-
-  if (b_parent.ptr.data != b_ob.ptr.data) {
-    visibility &= object_ray_visibility(b_parent);
+  /* Settings shared by all instances of this object, looked up only once. */
+  ObjectKey prototype_key(b_parent, NULL, b_ob_instance, use_particle_hair);
+  map<ObjectKey, InstancePrototype>::iterator prototype_it = instance_prototypes.end();
+  if (is_instance) {
+    prototype_it = instance_prototypes.find(prototype_key);
   }
 
-  /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
-#if 0
-  if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
-    visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
+  InstancePrototype prototype;
+  if (prototype_it != instance_prototypes.end()) {
+    prototype = prototype_it->second;
   }
+  else {
+    prototype.geometry = NULL;
+
+    /* Visibility flags for both parent and child. */
+    PointerRNA cobject = RNA_pointer_get(&b_ob.ptr, "cycles");
+    prototype.use_holdout = get_boolean(cobject, "is_holdout") ||
+                            b_parent.holdout_get(PointerRNA_NULL, b_view_layer);
+    prototype.visibility = object_ray_visibility(b_ob) & PATH_RAY_ALL_VISIBILITY;
+
+    if (b_parent.ptr.data != b_ob.ptr.data) {
+      prototype.visibility &= object_ray_visibility(b_parent);
+    }
+
+    /* TODO: make holdout objects on excluded layer invisible for non-camera rays. */
+#if 0
+    if (use_holdout && (layer_flag & view_layer.exclude_layer)) {
+      visibility &= ~(PATH_RAY_ALL_VISIBILITY - PATH_RAY_CAMERA);
+    }
 #endif
 
-  /* Clear camera visibility for indirect only objects. */
-  bool use_indirect_only = !use_holdout &&
-                           b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
-  if (use_indirect_only) {
-    visibility &= ~PATH_RAY_CAMERA;
+    /* Clear camera visibility for indirect only objects. */
+    bool use_indirect_only = !prototype.use_holdout &&
+                             b_parent.indirect_only_get(PointerRNA_NULL, b_view_layer);
+    if (use_indirect_only) {
+      prototype.visibility &= ~PATH_RAY_CAMERA;
+    }
+
+    prototype.is_shadow_catcher = get_boolean(cobject, "is_shadow_catcher");
+    prototype.shadow_terminator_offset = get_float(cobject, "shadow_terminator_offset");
+
+    /* The asset name for Cryptomatte. */
+    BL::Object parent = b_ob.parent();
+    if (parent) {
+      while (parent.parent()) {
+        parent = parent.parent();
+      }
+      prototype.asset_name = parent.name();
+    }
+    else {
+      prototype.asset_name = b_ob.name();
+    }
+
+    prototype.name = b_ob.name().c_str();
+    prototype.pass_id = b_ob.pass_index();
+    prototype.color = get_float3(b_ob.color());
+
+    /* Motion blur. */
+    if (scene->need_motion() == Scene::MOTION_BLUR) {
+      prototype.motion_steps = object_motion_steps(b_parent, b_ob, Object::MAX_MOTION_STEPS);
+      prototype.use_deform_motion = prototype.motion_steps &&
+                                    object_use_deform_motion(b_parent, b_ob);
+    }
+    else {
+      prototype.motion_steps = 3;
+      prototype.use_deform_motion = false;
+    }
+
+    if (is_instance) {
+      prototype_it = instance_prototypes.insert(std::make_pair(prototype_key, prototype)).first;
+    }
   }
 
   /* Don't export completely invisible objects. */
-  if (visibility == 0) {
+  if (prototype.visibility == 0) {
     return NULL;
   }
 
@@ -210,50 +259,44 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
   if (object_map.add_or_update(scene, &object, b_ob, b_parent, key))
     object_updated = true;
 
-  /* mesh sync */
-  object->geometry = sync_geometry(
-      b_depsgraph, b_ob, b_ob_instance, object_updated, use_particle_hair);
+  /* mesh sync, instances of the same object share the geometry synced for the first one */
+  if (prototype.geometry == NULL) {
+    prototype.geometry = sync_geometry(
+        b_depsgraph, b_ob, b_ob_instance, object_updated, use_particle_hair);
+
+    if (prototype_it != instance_prototypes.end()) {
+      prototype_it->second.geometry = prototype.geometry;
+    }
+  }
+  object->geometry = prototype.geometry;
 
   /* special case not tracked by object update flags */
 
   /* holdout */
-  if (use_holdout != object->use_holdout) {
-    object->use_holdout = use_holdout;
+  if (prototype.use_holdout != object->use_holdout) {
+    object->use_holdout = prototype.use_holdout;
     scene->object_manager->tag_update(scene);
     object_updated = true;
   }
 
-  if (visibility != object->visibility) {
-    object->visibility = visibility;
+  if (prototype.visibility != object->visibility) {
+    object->visibility = prototype.visibility;
     object_updated = true;
   }
 
-  bool is_shadow_catcher = get_boolean(cobject, "is_shadow_catcher");
-  if (is_shadow_catcher != object->is_shadow_catcher) {
-    object->is_shadow_catcher = is_shadow_catcher;
+  if (prototype.is_shadow_catcher != object->is_shadow_catcher) {
+    object->is_shadow_catcher = prototype.is_shadow_catcher;
     object_updated = true;
   }
 
-  float shadow_terminator_offset = get_float(cobject, "shadow_terminator_offset");
-  if (shadow_terminator_offset != object->shadow_terminator_offset) {
-    object->shadow_terminator_offset = shadow_terminator_offset;
+  if (prototype.shadow_terminator_offset != object->shadow_terminator_offset) {
+    object->shadow_terminator_offset = prototype.shadow_terminator_offset;
     object_updated = true;
   }
 
   /* sync the asset name for Cryptomatte */
-  BL::Object parent = b_ob.parent();
-  ustring parent_name;
-  if (parent) {
-    while (parent.parent()) {
-      parent = parent.parent();
-    }
-    parent_name = parent.name();
-  }
-  else {
-    parent_name = b_ob.name();
-  }
-  if (object->asset_name != parent_name) {
-    object->asset_name = parent_name;
+  if (object->asset_name != prototype.asset_name) {
+    object->asset_name = prototype.asset_name;
     object_updated = true;
   }
 
@@ -262,9 +305,9 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
    * in the depsgraph and may not signal changes, so this is a workaround */
   if (object_updated || (object->geometry && object->geometry->need_update) ||
       tfm != object->tfm) {
-    object->name = b_ob.name().c_str();
-    object->pass_id = b_ob.pass_index();
-    object->color = get_float3(b_ob.color());
+    object->name = prototype.name;
+    object->pass_id = prototype.pass_id;
+    object->color = prototype.color;
     object->tfm = tfm;
     object->motion.clear();
 
@@ -272,22 +315,10 @@ Object *BlenderSync::sync_object(BL::Depsgraph &b_depsgraph,
     Scene::MotionType need_motion = scene->need_motion();
     if (need_motion != Scene::MOTION_NONE && object->geometry) {
       Geometry *geom = object->geometry;
-      geom->use_motion_blur = false;
-      geom->motion_steps = 0;
+      uint motion_steps = prototype.motion_steps;
 
-      uint motion_steps;
-
-      if (need_motion == Scene::MOTION_BLUR) {
-        motion_steps = object_motion_steps(b_parent, b_ob, Object::MAX_MOTION_STEPS);
-        geom->motion_steps = motion_steps;
-        if (motion_steps && object_use_deform_motion(b_parent, b_ob)) {
-          geom->use_motion_blur = true;
-        }
-      }
-      else {
-        motion_steps = 3;
-        geom->motion_steps = motion_steps;
-      }
+      geom->motion_steps = motion_steps;
+      geom->use_motion_blur = prototype.use_deform_motion;
 
       object->motion.clear();
       object->motion.resize(motion_steps, transform_empty());
@@ -334,6 +365,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
   /* layer data */
   bool motion = motion_time != 0.0f;
 
+  instance_prototypes.clear();
+
   if (!motion) {
     /* prepare for sync */
     light_map.pre_sync();
@@ -413,6 +446,8 @@ void BlenderSync::sync_objects(BL::Depsgraph &b_depsgraph,
 
   if (motion)
     geometry_motion_synced.clear();
+
+  instance_prototypes.clear();
 }
 
 void BlenderSync::sync_motion(BL::RenderSettings &b_render,
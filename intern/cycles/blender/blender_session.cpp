@@ -495,6 +495,19 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
   /* Update denoising parameters. */
   session->set_denoising(session_params.denoising);
 
+  /* Tile checkpoints, stored per view layer and frame so that layers and frames of an
+   * animation do not reuse each other's tiles. */
+  PointerRNA cscene = RNA_pointer_get(&b_scene.ptr, "cycles");
+  const string checkpoint_directory = get_string(cscene, "checkpoint_directory");
+  if (background && !checkpoint_directory.empty()) {
+    session->params.checkpoint_path = path_join(
+        blender_absolute_path(b_data, b_scene, checkpoint_directory),
+        string_printf("%s_%04d", b_view_layer.name().c_str(), b_scene.frame_current()));
+  }
+  else {
+    session->params.checkpoint_path = "";
+  }
+
   /* Compute render passes and film settings. */
   vector<Pass> passes = sync->sync_render_passes(
       b_rlay, b_view_layer, session_params.adaptive_sampling, session_params.denoising);
@@ -641,8 +654,20 @@ void BlenderSession::bake(BL::Depsgraph &b_depsgraph_,
   ShaderEvalType shader_type = get_shader_type(pass_type);
   int bake_pass_filter = bake_pass_filter_get(pass_filter);
 
+  /* Objects to bake, indexed by the object ID of the bake pixels. Engines that do not provide
+   * the list bake the given object only. */
+  vector<string> object_names;
+  BL::RenderEngine::bake_objects_iterator b_bake_ob;
+  for (b_engine.bake_objects.begin(b_bake_ob); b_bake_ob != b_engine.bake_objects.end();
+       ++b_bake_ob) {
+    object_names.push_back(b_bake_ob->name());
+  }
+  if (object_names.empty()) {
+    object_names.push_back(b_object.name());
+  }
+
   /* Initialize bake manager, before we load the baking kernels. */
-  scene->bake_manager->set(scene, b_object.name(), shader_type, bake_pass_filter);
+  scene->bake_manager->set(scene, object_names, shader_type, bake_pass_filter);
 
   /* Passes are identified by name, so in order to return the combined pass we need to set the
    * name. */
@@ -660,11 +685,12 @@ void BlenderSession::bake(BL::Depsgraph &b_depsgraph_,
     builtin_images_load();
   }
 
-  /* Object might have been disabled for rendering or excluded in some
+  /* Objects might have been disabled for rendering or excluded in some
    * other way, in that case Blender will report a warning afterwards. */
   bool object_found = false;
   foreach (Object *ob, scene->objects) {
-    if (ob->name == b_object.name()) {
+    if (std::find(object_names.begin(), object_names.end(), ob->name.string()) !=
+        object_names.end()) {
       object_found = true;
       break;
     }
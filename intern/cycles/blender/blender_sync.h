@@ -224,6 +224,24 @@ class BlenderSync {
   set<Geometry *> geometry_synced;
   set<Geometry *> geometry_motion_synced;
   set<float> motion_times;
+
+  /* Settings shared by all instances of the same object from the same parent.
+   * Only the transform and instance attributes differ between them, so these
+   * are looked up once per sync instead of once per instance. */
+  struct InstancePrototype {
+    Geometry *geometry;
+    uint visibility;
+    bool use_holdout;
+    bool is_shadow_catcher;
+    float shadow_terminator_offset;
+    ustring name;
+    ustring asset_name;
+    int pass_id;
+    float3 color;
+    uint motion_steps;
+    bool use_deform_motion;
+  };
+  map<ObjectKey, InstancePrototype> instance_prototypes;
   void *world_map;
   bool world_recalc;
   BlenderViewportParameters viewport_parameters;
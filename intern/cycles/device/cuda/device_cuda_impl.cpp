@@ -1912,6 +1912,7 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
     /* Setup and copy work tile to device. */
     wtile->start_sample = sample;
     wtile->num_samples = min(step_samples, end_sample - sample);
+    wtile->any_active = 0;
     work_tiles.copy_to_device();
 
     CUdeviceptr d_work_tiles = (CUdeviceptr)work_tiles.device_pointer;
@@ -1926,12 +1927,25 @@ void CUDADevice::render(DeviceTask &task, RenderTile &rtile, device_vector<WorkT
 
     /* Run the adaptive sampling kernels at selected samples aligned to step samples. */
     uint filter_sample = sample + wtile->num_samples - 1;
-    if (task.adaptive_sampling.use && task.adaptive_sampling.need_filter(filter_sample)) {
+    const bool need_filter = task.adaptive_sampling.use &&
+                             task.adaptive_sampling.need_filter(filter_sample);
+    if (need_filter) {
       adaptive_sampling_filter(filter_sample, wtile, d_work_tiles);
     }
 
     cuda_assert(cuCtxSynchronize());
 
+    /* Stop early once every pixel in the tile has converged, like the CPU
+     * device does, so the remaining samples go to other tiles instead. */
+    if (need_filter) {
+      work_tiles.copy_from_device(0, 1, 1);
+      if (!wtile->any_active) {
+        rtile.sample = end_sample;
+        task.update_progress(&rtile, rtile.w * rtile.h * (end_sample - sample));
+        break;
+      }
+    }
+
     /* Update progress. */
     rtile.sample = sample + wtile->num_samples;
     task.update_progress(&rtile, rtile.w * rtile.h * wtile->num_samples);
@@ -2352,7 +2366,7 @@ void CUDADevice::thread_run(DeviceTask &task)
       }
     }
 
-    device_vector<WorkTile> work_tiles(this, "work_tiles", MEM_READ_ONLY);
+    device_vector<WorkTile> work_tiles(this, "work_tiles", MEM_READ_WRITE);
 
     /* keep rendering tiles until done */
     RenderTile tile;
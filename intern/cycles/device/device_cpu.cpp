@@ -312,7 +312,8 @@ class CPUDevice : public Device {
 #ifdef WITH_EMBREE
     embree_device = rtcNewDevice("verbose=0");
 #endif
-    use_split_kernel = DebugFlags().cpu.split_kernel;
+    /* Split kernel accumulates samples with atomics, in no fixed order. */
+    use_split_kernel = DebugFlags().cpu.split_kernel && !DebugFlags().cpu.deterministic;
     if (use_split_kernel) {
       VLOG(1) << "Will be using split kernel.";
     }
@@ -365,7 +366,9 @@ class CPUDevice : public Device {
   {
     BVHLayoutMask bvh_layout_mask = BVH_LAYOUT_BVH2;
 #ifdef WITH_EMBREE
-    bvh_layout_mask |= BVH_LAYOUT_EMBREE;
+    if (!DebugFlags().cpu.deterministic) {
+      bvh_layout_mask |= BVH_LAYOUT_EMBREE;
+    }
 #endif /* WITH_EMBREE */
     return bvh_layout_mask;
   }
@@ -1623,6 +1626,7 @@ void device_cpu_info(vector<DeviceInfo> &devices)
   info.id = "CPU";
   info.num = 0;
   info.has_volume_decoupled = true;
+  info.has_sparse_volumes = true;
   info.has_adaptive_stop_per_sample = true;
   info.has_osl = true;
   info.has_half_images = true;
@@ -224,6 +224,8 @@ class device_memory {
   void *shared_pointer;
   /* reference counter for shared_pointer */
   int shared_counter;
+  /* Host data was changed since it was last copied to the device. */
+  bool modified;
 
   virtual ~device_memory();
 
@@ -347,6 +349,7 @@ template<typename T> class device_vector : public device_memory {
       device_free();
       host_free();
       host_pointer = host_alloc(sizeof(T) * new_size);
+      modified = true;
       assert(device_pointer == 0);
     }
 
@@ -375,6 +378,7 @@ template<typename T> class device_vector : public device_memory {
       device_free();
       host_free();
       host_pointer = new_ptr;
+      modified = true;
       assert(device_pointer == 0);
     }
 
@@ -397,6 +401,7 @@ template<typename T> class device_vector : public device_memory {
     data_height = 0;
     data_depth = 0;
     host_pointer = from.steal_pointer();
+    modified = true;
     assert(device_pointer == 0);
   }
 
@@ -411,6 +416,7 @@ template<typename T> class device_vector : public device_memory {
     data_height = 0;
     data_depth = 0;
     host_pointer = 0;
+    modified = true;
     assert(device_pointer == 0);
   }
 
@@ -433,6 +439,26 @@ template<typename T> class device_vector : public device_memory {
   void copy_to_device()
   {
     device_copy_to();
+    modified = false;
+  }
+
+  /* Only copy to the device if the host data was tagged as modified, or the
+   * memory was (re)allocated since the last copy. */
+  void copy_to_device_if_modified()
+  {
+    if (modified) {
+      copy_to_device();
+    }
+  }
+
+  void tag_modified()
+  {
+    modified = true;
+  }
+
+  bool is_modified() const
+  {
+    return modified;
   }
 
   void copy_from_device()
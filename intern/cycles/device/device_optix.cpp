@@ -728,6 +728,7 @@ class OptiXDevice : public CUDADevice {
       // Copy work tile information to device
       wtile.num_samples = min(step_samples, end_sample - sample);
       wtile.start_sample = sample;
+      wtile.any_active = 0;
       device_ptr d_wtile_ptr = launch_params_ptr + offsetof(KernelParams, tile);
       check_result_cuda(
           cuMemcpyHtoDAsync(d_wtile_ptr, &wtile, sizeof(wtile), cuda_stream[thread_index]));
@@ -761,13 +762,27 @@ class OptiXDevice : public CUDADevice {
 
       // Run the adaptive sampling kernels at selected samples aligned to step samples.
       uint filter_sample = wtile.start_sample + wtile.num_samples - 1;
-      if (task.adaptive_sampling.use && task.adaptive_sampling.need_filter(filter_sample)) {
+      const bool need_filter = task.adaptive_sampling.use &&
+                               task.adaptive_sampling.need_filter(filter_sample);
+      if (need_filter) {
         adaptive_sampling_filter(filter_sample, &wtile, d_wtile_ptr, cuda_stream[thread_index]);
+        // Read back whether any pixel in the tile still needs more samples
+        check_result_cuda(cuMemcpyDtoHAsync(&wtile.any_active,
+                                            d_wtile_ptr + offsetof(WorkTile, any_active),
+                                            sizeof(wtile.any_active),
+                                            cuda_stream[thread_index]));
       }
 
       // Wait for launch to finish
       check_result_cuda(cuStreamSynchronize(cuda_stream[thread_index]));
 
+      // Stop early once all pixels converged, so the remaining samples go to other tiles
+      if (need_filter && !wtile.any_active) {
+        rtile.sample = end_sample;
+        task.update_progress(&rtile, wtile.w * wtile.h * (end_sample - sample));
+        break;
+      }
+
       // Update current sample, so it is displayed correctly
       rtile.sample = wtile.start_sample + wtile.num_samples;
       // Update task progress after the kernel completed rendering
@@ -72,17 +72,43 @@ ccl_device_inline void kernel_filter_nlm_blur(
     const float *ccl_restrict difference_image, float *out_image, int4 rect, int stride, int f)
 {
   int aligned_lowx = round_down(rect.x, 4);
+
+  /* Vertical box filter as a running sum over the rows, so that the cost per pixel
+   * does not depend on the filter radius. The sum is recomputed once per filter
+   * height to keep precision loss and non-finite values from spreading across the
+   * whole tile. The sums are normalized in a second pass. */
   for (int y = rect.y; y < rect.w; y++) {
-    const int low = max(rect.y, y - f);
-    const int high = min(rect.w, y + f + 1);
-    for (int x = aligned_lowx; x < rect.z; x += 4) {
-      load4_a(out_image, y * stride + x) = make_float4(0.0f);
-    }
-    for (int y1 = low; y1 < high; y1++) {
+    if ((y - rect.y) % (2 * f + 1) == 0) {
+      const int low = max(rect.y, y - f);
+      const int high = min(rect.w, y + f + 1);
       for (int x = aligned_lowx; x < rect.z; x += 4) {
-        load4_a(out_image, y * stride + x) += load4_a(difference_image, y1 * stride + x);
+        load4_a(out_image, y * stride + x) = make_float4(0.0f);
+      }
+      for (int y1 = low; y1 < high; y1++) {
+        for (int x = aligned_lowx; x < rect.z; x += 4) {
+          load4_a(out_image, y * stride + x) += load4_a(difference_image, y1 * stride + x);
+        }
       }
+      continue;
     }
+
+    const int add_y = y + f;
+    const int sub_y = y - f - 1;
+    for (int x = aligned_lowx; x < rect.z; x += 4) {
+      float4 sum = load4_a(out_image, (y - 1) * stride + x);
+      if (add_y < rect.w) {
+        sum += load4_a(difference_image, add_y * stride + x);
+      }
+      if (sub_y >= rect.y) {
+        sum -= load4_a(difference_image, sub_y * stride + x);
+      }
+      load4_a(out_image, y * stride + x) = sum;
+    }
+  }
+
+  for (int y = rect.y; y < rect.w; y++) {
+    const int low = max(rect.y, y - f);
+    const int high = min(rect.w, y + f + 1);
     float fac = 1.0f / (high - low);
     for (int x = aligned_lowx; x < rect.z; x += 4) {
       load4_a(out_image, y * stride + x) *= fac;
@@ -166,6 +166,34 @@ ccl_device_inline float2 half_plane_intersect(const float3 P, const float3 N, co
   return make_float2(lower, upper);
 }
 
+/* Bezier control points of a Catmull-Rom segment. Unlike the Catmull-Rom control points these
+ * bound the segment, which makes them suitable for culling. */
+ccl_device_inline void curve_bezier_points(const float4 curve[4], float4 bezier[4])
+{
+  bezier[0] = curve[1];
+  bezier[1] = curve[1] + (curve[2] - curve[0]) * (1.0f / 6.0f);
+  bezier[2] = curve[2] - (curve[3] - curve[1]) * (1.0f / 6.0f);
+  bezier[3] = curve[2];
+}
+
+ccl_device_inline bool curve_bounding_sphere_test(const float4 curve[4],
+                                                  const float3 center,
+                                                  const float dt,
+                                                  const float length_ray_dir,
+                                                  const float ray_tfar)
+{
+  float4 bezier[4];
+  curve_bezier_points(curve, bezier);
+
+  float radius = 0.0f;
+  for (int i = 0; i < 4; i++) {
+    radius = max(radius, len(float4_to_float3(bezier[i]) - center) + fabsf(bezier[i].w));
+  }
+
+  const float radius_t = radius / length_ray_dir;
+  return dot(center, center) <= sqr(radius) && dt + radius_t >= 0.0f && dt - radius_t <= ray_tfar;
+}
+
 ccl_device bool curve_intersect_iterative(const float3 ray_dir,
                                           const float dt,
                                           const float4 curve[4],
@@ -272,6 +300,12 @@ ccl_device bool curve_intersect_recursive(const float3 ray_orig,
   curve[2] -= ref4;
   curve[3] -= ref4;
 
+  /* Cull against a sphere bounding the Bezier control points of the segment, before any of
+   * the cylinder tests. The ray passes closest to its center at the reference point. */
+  if (!curve_bounding_sphere_test(curve, center - ref, dt, len(ray_dir), isect->t)) {
+    return false;
+  }
+
   const bool use_backfacing = false;
   const float step_size = 1.0f / (float)(CURVE_NUM_BEZIER_STEPS);
 
@@ -554,6 +588,20 @@ ccl_device_inline bool ribbon_intersect(const float3 ray_org,
   curve[2] = ribbon_to_ray_space(ray_space, ray_org, curve[2]);
   curve[3] = ribbon_to_ray_space(ray_space, ray_org, curve[3]);
 
+  /* Cull the segment by the bounds of its Bezier control points in ray space, before evaluating
+   * any of the subdivision steps. */
+  float4 bezier[4];
+  curve_bezier_points(curve, bezier);
+
+  const float4 bmin = min(min(bezier[0], bezier[1]), min(bezier[2], bezier[3]));
+  const float4 bmax = max(max(bezier[0], bezier[1]), max(bezier[2], bezier[3]));
+  const float radius_max = max(fabsf(bmin.w), fabsf(bmax.w));
+
+  if (bmin.x > radius_max || bmax.x < -radius_max || bmin.y > radius_max ||
+      bmax.y < -radius_max || bmax.z < 0.0f || bmin.z > ray_tfar) {
+    return false;
+  }
+
   const float4 mx = max(max(fabs(curve[0]), fabs(curve[1])), max(fabs(curve[2]), fabs(curve[3])));
   const float eps = 4.0f * FLT_EPSILON * max(max(mx.x, mx.y), max(mx.z, mx.w));
   const float step_size = 1.0f / (float)N;
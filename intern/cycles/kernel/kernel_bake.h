@@ -237,7 +237,13 @@ ccl_device void kernel_bake_evaluate(
   if (prim == -1)
     return;
 
-  prim += kernel_data.bake.tri_offset;
+  /* Map the object ID of the pixel to the object being baked. */
+  const uint2 bake_object = kernel_tex_fetch(__bake_objects, __float_as_uint(primitive[0]));
+  int object = bake_object.x;
+  if (object == OBJECT_NONE)
+    return;
+
+  prim += bake_object.y;
 
   /* Random number generator. */
   uint rng_hash = hash_uint2(x, y) ^ kernel_data.integrator.seed;
@@ -267,7 +273,6 @@ ccl_device void kernel_bake_evaluate(
   }
 
   /* Shader data setup. */
-  int object = kernel_data.bake.object_index;
   int shader;
   float3 P, Ng;
 
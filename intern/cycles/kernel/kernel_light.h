@@ -328,12 +328,21 @@ ccl_device_inline bool triangle_world_space_vertices(
   return has_motion;
 }
 
+/* pdf_triangles is computed over triangle area weighted by the estimated
+ * emission strength of the shader, see LightManager::device_update_distribution. */
+ccl_device_inline float triangle_light_pdf_scale(KernelGlobals *kg, int shader)
+{
+  return kernel_data.integrator.pdf_triangles *
+         kernel_tex_fetch(__shaders, (shader & SHADER_MASK)).emission_estimate;
+}
+
 ccl_device_inline float triangle_light_pdf_area(KernelGlobals *kg,
+                                                int shader,
                                                 const float3 Ng,
                                                 const float3 I,
                                                 float t)
 {
-  float pdf = kernel_data.integrator.pdf_triangles;
+  float pdf = triangle_light_pdf_scale(kg, shader);
   float cos_pi = fabsf(dot(Ng, I));
 
   if (cos_pi == 0.0f)
@@ -389,12 +398,12 @@ ccl_device_forceinline float triangle_light_pdf(KernelGlobals *kg, ShaderData *s
       else {
         area = 0.5f * len(N);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * triangle_light_pdf_scale(kg, sd->shader);
       return pdf / solid_angle;
     }
   }
   else {
-    float pdf = triangle_light_pdf_area(kg, sd->Ng, sd->I, t);
+    float pdf = triangle_light_pdf_area(kg, sd->shader, sd->Ng, sd->I, t);
     if (has_motion) {
       const float area = 0.5f * len(N);
       if (UNLIKELY(area == 0.0f)) {
@@ -542,7 +551,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
         triangle_world_space_vertices(kg, object, prim, -1.0f, V);
         area = triangle_area(V[0], V[1], V[2]);
       }
-      const float pdf = area * kernel_data.integrator.pdf_triangles;
+      const float pdf = area * triangle_light_pdf_scale(kg, ls->shader);
       ls->pdf = pdf / solid_angle;
     }
   }
@@ -564,7 +573,7 @@ ccl_device_forceinline void triangle_light_sample(KernelGlobals *kg,
     ls->P = u * V[0] + v * V[1] + t * V[2];
     /* compute incoming direction, distance and pdf */
     ls->D = normalize_len(ls->P - P, &ls->t);
-    ls->pdf = triangle_light_pdf_area(kg, ls->Ng, -ls->D, ls->t);
+    ls->pdf = triangle_light_pdf_area(kg, ls->shader, ls->Ng, -ls->D, ls->t);
     if (has_motion && area != 0.0f) {
       /* scale the PDF.
        * area = the area the sample was taken from
@@ -86,4 +86,7 @@ KERNEL_TEX(TextureInfo, __texture_info)
 /* ies lights */
 KERNEL_TEX(float, __ies)
 
+/* bake */
+KERNEL_TEX(uint2, __bake_objects)
+
 #undef KERNEL_TEX
@@ -1437,10 +1437,9 @@ typedef struct KernelTables {
 static_assert_align(KernelTables, 16);
 
 typedef struct KernelBake {
-  int object_index;
-  int tri_offset;
   int type;
   int pass_filter;
+  int pad1, pad2;
 } KernelBake;
 static_assert_align(KernelBake, 16);
 
@@ -1567,7 +1566,8 @@ typedef struct KernelShader {
   float cryptomatte_id;
   int flags;
   int pass_id;
-  int pad2, pad3;
+  float emission_estimate;
+  int pad3;
 } KernelShader;
 static_assert_align(KernelShader, 16);
 
@@ -1696,6 +1696,9 @@ typedef struct WorkTile {
   int offset;
   uint stride;
 
+  /* Set by the adaptive sampling filter when any pixel still needs samples. */
+  uint any_active;
+
   ccl_global float *buffer;
 } WorkTile;
 
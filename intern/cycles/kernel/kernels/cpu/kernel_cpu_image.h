@@ -452,12 +452,125 @@ template<typename T> struct TextureInterpolator {
 #undef DATA
   }
 
+  /* ********  3D sparse tile interpolation ******** */
+
+  static ccl_always_inline int wrap_sparse(int x, int width, int extension)
+  {
+    return (extension == EXTENSION_REPEAT) ? wrap_periodic(x, width) : wrap_clamp(x, width);
+  }
+
+  static ccl_always_inline float4 read_sparse(const TextureInfo &info, int x, int y, int z)
+  {
+    const int *offsets = (const int *)info.data;
+    const int tiles_x = (info.width + TEX_SPARSE_TILE_SIZE - 1) >> TEX_SPARSE_TILE_SHIFT;
+    const int tiles_y = (info.height + TEX_SPARSE_TILE_SIZE - 1) >> TEX_SPARSE_TILE_SHIFT;
+    const int tile = (x >> TEX_SPARSE_TILE_SHIFT) +
+                     tiles_x * ((y >> TEX_SPARSE_TILE_SHIFT) +
+                                tiles_y * (z >> TEX_SPARSE_TILE_SHIFT));
+
+    /* Empty tiles are skipped without touching any voxel memory. */
+    const int offset = offsets[tile];
+    if (offset < 0) {
+      return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    const int mask = TEX_SPARSE_TILE_SIZE - 1;
+    const int voxel = (x & mask) + ((y & mask) << TEX_SPARSE_TILE_SHIFT) +
+                      ((z & mask) << (2 * TEX_SPARSE_TILE_SHIFT));
+
+    const T *data = (const T *)info.data;
+    return read(data[(size_t)offset + voxel]);
+  }
+
+  static ccl_always_inline float4 interp_3d_sparse(
+      const TextureInfo &info, float x, float y, float z, InterpolationType interp)
+  {
+    const int width = info.width;
+    const int height = info.height;
+    const int depth = info.depth;
+    const int extension = info.extension;
+
+    if (extension == EXTENSION_CLIP) {
+      if (x < 0.0f || y < 0.0f || z < 0.0f || x > 1.0f || y > 1.0f || z > 1.0f) {
+        return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+      }
+    }
+
+    int ix, iy, iz;
+
+    if (interp == INTERPOLATION_CLOSEST) {
+      frac(x * (float)width, &ix);
+      frac(y * (float)height, &iy);
+      frac(z * (float)depth, &iz);
+
+      return read_sparse(info,
+                         wrap_sparse(ix, width, extension),
+                         wrap_sparse(iy, height, extension),
+                         wrap_sparse(iz, depth, extension));
+    }
+
+    const float tx = frac(x * (float)width - 0.5f, &ix);
+    const float ty = frac(y * (float)height - 0.5f, &iy);
+    const float tz = frac(z * (float)depth - 0.5f, &iz);
+
+    if (interp == INTERPOLATION_LINEAR) {
+      const int xc[2] = {wrap_sparse(ix, width, extension), wrap_sparse(ix + 1, width, extension)};
+      const int yc[2] = {wrap_sparse(iy, height, extension),
+                         wrap_sparse(iy + 1, height, extension)};
+      const int zc[2] = {wrap_sparse(iz, depth, extension), wrap_sparse(iz + 1, depth, extension)};
+
+      float4 r;
+      r = (1.0f - tz) * (1.0f - ty) * (1.0f - tx) * read_sparse(info, xc[0], yc[0], zc[0]);
+      r += (1.0f - tz) * (1.0f - ty) * tx * read_sparse(info, xc[1], yc[0], zc[0]);
+      r += (1.0f - tz) * ty * (1.0f - tx) * read_sparse(info, xc[0], yc[1], zc[0]);
+      r += (1.0f - tz) * ty * tx * read_sparse(info, xc[1], yc[1], zc[0]);
+
+      r += tz * (1.0f - ty) * (1.0f - tx) * read_sparse(info, xc[0], yc[0], zc[1]);
+      r += tz * (1.0f - ty) * tx * read_sparse(info, xc[1], yc[0], zc[1]);
+      r += tz * ty * (1.0f - tx) * read_sparse(info, xc[0], yc[1], zc[1]);
+      r += tz * ty * tx * read_sparse(info, xc[1], yc[1], zc[1]);
+      return r;
+    }
+
+    int xc[4], yc[4], zc[4];
+    float u[4], v[4], w[4];
+
+    for (int i = 0; i < 4; i++) {
+      xc[i] = wrap_sparse(ix + i - 1, width, extension);
+      yc[i] = wrap_sparse(iy + i - 1, height, extension);
+      zc[i] = wrap_sparse(iz + i - 1, depth, extension);
+    }
+
+    SET_CUBIC_SPLINE_WEIGHTS(u, tx);
+    SET_CUBIC_SPLINE_WEIGHTS(v, ty);
+    SET_CUBIC_SPLINE_WEIGHTS(w, tz);
+
+    float4 r = make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+    for (int k = 0; k < 4; k++) {
+      for (int j = 0; j < 4; j++) {
+        float4 row = make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+        for (int i = 0; i < 4; i++) {
+          row += u[i] * read_sparse(info, xc[i], yc[j], zc[k]);
+        }
+        r += w[k] * v[j] * row;
+      }
+    }
+    return r;
+  }
+
   static ccl_always_inline float4
   interp_3d(const TextureInfo &info, float x, float y, float z, InterpolationType interp)
   {
     if (UNLIKELY(!info.data))
       return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
 
+    if (info.use_sparse_tiles) {
+      if (interp == INTERPOLATION_NONE) {
+        interp = (InterpolationType)info.interpolation;
+      }
+      return interp_3d_sparse(info, x, y, z, interp);
+    }
+
     switch ((interp == INTERPOLATION_NONE) ? info.interpolation : interp) {
       case INTERPOLATION_CLOSEST:
         return interp_3d_closest(info, x, y, z);
@@ -22,6 +22,7 @@
 #include "render/shader.h"
 
 #include "util/util_foreach.h"
+#include "util/util_map.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -85,15 +86,15 @@ BakeManager::~BakeManager()
 
 bool BakeManager::get_baking()
 {
-  return !object_name.empty();
+  return !object_names.empty();
 }
 
 void BakeManager::set(Scene *scene,
-                      const std::string &object_name_,
+                      const vector<std::string> &object_names_,
                       ShaderEvalType type_,
                       int pass_filter_)
 {
-  object_name = object_name_;
+  object_names = object_names_;
   type = type_;
   pass_filter = shader_type_to_pass_filter(type_, pass_filter_);
 
@@ -131,24 +132,53 @@ void BakeManager::device_update(Device * /*device*/,
   kbake->type = type;
   kbake->pass_filter = pass_filter;
 
+  dscene->bake_objects.free();
+
+  if (!get_baking()) {
+    need_update = false;
+    return;
+  }
+
+  /* Map from object ID to object index and triangle offset, so that all objects are baked
+   * in a single sampling run. Objects that are not in the scene are skipped. Like baking a
+   * single object did, the first scene object with a matching name is used. */
+  map<std::string, vector<size_t>> object_ids;
+  uint2 *bake_objects = dscene->bake_objects.alloc(object_names.size());
+
+  for (size_t i = 0; i < object_names.size(); i++) {
+    object_ids[object_names[i]].push_back(i);
+    bake_objects[i] = make_uint2(OBJECT_NONE, 0);
+  }
+
+  int max_aa_samples = 0;
   int object_index = 0;
   foreach (Object *object, scene->objects) {
     const Geometry *geom = object->geometry;
-    if (object->name == object_name && geom->type == Geometry::MESH) {
-      kbake->object_index = object_index;
-      kbake->tri_offset = geom->prim_offset;
-      kintegrator->aa_samples = aa_samples(scene, object, type);
-      break;
+    map<std::string, vector<size_t>>::iterator it = object_ids.find(object->name.string());
+
+    if (it != object_ids.end() && geom->type == Geometry::MESH) {
+      foreach (size_t id, it->second) {
+        bake_objects[id] = make_uint2(object_index, geom->prim_offset);
+      }
+      max_aa_samples = max(max_aa_samples, aa_samples(scene, object, type));
+      object_ids.erase(it);
     }
 
     object_index++;
   }
 
+  if (max_aa_samples > 0) {
+    kintegrator->aa_samples = max_aa_samples;
+  }
+
+  dscene->bake_objects.copy_to_device();
+
   need_update = false;
 }
 
-void BakeManager::device_free(Device * /*device*/, DeviceScene * /*dscene*/)
+void BakeManager::device_free(Device * /*device*/, DeviceScene *dscene)
 {
+  dscene->bake_objects.free();
 }
 
 CCL_NAMESPACE_END
@@ -30,7 +30,10 @@ class BakeManager {
   BakeManager();
   ~BakeManager();
 
-  void set(Scene *scene, const std::string &object_name, ShaderEvalType type, int pass_filter);
+  void set(Scene *scene,
+           const vector<std::string> &object_names,
+           ShaderEvalType type,
+           int pass_filter);
   bool get_baking();
 
   void device_update(Device *device, DeviceScene *dscene, Scene *scene, Progress &progress);
@@ -41,7 +44,8 @@ class BakeManager {
  private:
   ShaderEvalType type;
   int pass_filter;
-  std::string object_name;
+  /* Objects to bake, indexed by the object ID stored in the bake primitive pass. */
+  vector<std::string> object_names;
 };
 
 CCL_NAMESPACE_END
@@ -505,6 +505,31 @@ static void update_attribute_element_size(Geometry *geom,
   }
 }
 
+/* Copy attribute data into its range of the packed array. Ranges that already
+ * hold identical data from a previous update are left alone, so the array is
+ * only tagged for re-upload when one of its attributes actually changed. */
+template<typename T>
+static void update_attribute_element_data(device_vector<T> &attr_array,
+                                          size_t offset,
+                                          const T *data,
+                                          size_t size)
+{
+  if (size == 0) {
+    return;
+  }
+
+  T *dst = &attr_array[offset];
+
+  if (!attr_array.is_modified()) {
+    if (memcmp(dst, data, sizeof(T) * size) == 0) {
+      return;
+    }
+    attr_array.tag_modified();
+  }
+
+  memcpy(dst, data, sizeof(T) * size);
+}
+
 static void update_attribute_element_offset(Geometry *geom,
                                             device_vector<float> &attr_float,
                                             size_t &attr_float_offset,
@@ -541,9 +566,7 @@ static void update_attribute_element_offset(Geometry *geom,
       offset = attr_uchar4_offset;
 
       assert(attr_uchar4.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_uchar4[offset + k] = data[k];
-      }
+      update_attribute_element_data(attr_uchar4, offset, data, size);
       attr_uchar4_offset += size;
     }
     else if (mattr->type == TypeDesc::TypeFloat) {
@@ -551,9 +574,7 @@ static void update_attribute_element_offset(Geometry *geom,
       offset = attr_float_offset;
 
       assert(attr_float.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_float[offset + k] = data[k];
-      }
+      update_attribute_element_data(attr_float, offset, data, size);
       attr_float_offset += size;
     }
     else if (mattr->type == TypeFloat2) {
@@ -561,9 +582,7 @@ static void update_attribute_element_offset(Geometry *geom,
       offset = attr_float2_offset;
 
       assert(attr_float2.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_float2[offset + k] = data[k];
-      }
+      update_attribute_element_data(attr_float2, offset, data, size);
       attr_float2_offset += size;
     }
     else if (mattr->type == TypeDesc::TypeMatrix) {
@@ -571,9 +590,7 @@ static void update_attribute_element_offset(Geometry *geom,
       offset = attr_float3_offset;
 
       assert(attr_float3.size() >= offset + size * 3);
-      for (size_t k = 0; k < size * 3; k++) {
-        attr_float3[offset + k] = (&tfm->x)[k];
-      }
+      update_attribute_element_data(attr_float3, offset, &tfm->x, size * 3);
       attr_float3_offset += size * 3;
     }
     else {
@@ -581,9 +598,7 @@ static void update_attribute_element_offset(Geometry *geom,
       offset = attr_float3_offset;
 
       assert(attr_float3.size() >= offset + size);
-      for (size_t k = 0; k < size; k++) {
-        attr_float3[offset + k] = data[k];
-      }
+      update_attribute_element_data(attr_float3, offset, data, size);
       attr_float3_offset += size;
     }
 
@@ -758,20 +773,21 @@ void GeometryManager::device_update_attributes(Device *device,
   if (progress.get_cancel())
     return;
 
-  /* copy to device */
+  /* copy to device, arrays in which no attribute changed since the previous
+   * update are still valid on the device */
   progress.set_status("Updating Mesh", "Copying Attributes to device");
 
   if (dscene->attributes_float.size()) {
-    dscene->attributes_float.copy_to_device();
+    dscene->attributes_float.copy_to_device_if_modified();
   }
   if (dscene->attributes_float2.size()) {
-    dscene->attributes_float2.copy_to_device();
+    dscene->attributes_float2.copy_to_device_if_modified();
   }
   if (dscene->attributes_float3.size()) {
-    dscene->attributes_float3.copy_to_device();
+    dscene->attributes_float3.copy_to_device_if_modified();
   }
   if (dscene->attributes_uchar4.size()) {
-    dscene->attributes_uchar4.copy_to_device();
+    dscene->attributes_uchar4.copy_to_device_if_modified();
   }
 
   if (progress.get_cancel())
@@ -1264,12 +1280,17 @@ void GeometryManager::device_update(Device *device,
     }
   }
 
-  /* Tessellate meshes that are using subdivision */
+  /* Tessellate meshes that are using subdivision. Meshes are independent, so they are
+   * tessellated in parallel, and each of them dices its patches in parallel as well. */
   if (total_tess_needed) {
     Camera *dicing_camera = scene->dicing_camera;
     dicing_camera->update(scene);
 
-    size_t i = 0;
+    progress.set_status("Updating Mesh",
+                        string_printf("Tessellating %u meshes", (uint)total_tess_needed));
+
+    TaskPool pool;
+
     foreach (Geometry *geom, scene->geometry) {
       if (!(geom->need_update && geom->type == Geometry::MESH)) {
         continue;
@@ -1278,25 +1299,23 @@ void GeometryManager::device_update(Device *device,
       Mesh *mesh = static_cast<Mesh *>(geom);
       if (mesh->subdivision_type != Mesh::SUBDIVISION_NONE && mesh->num_subd_verts == 0 &&
           mesh->subd_params) {
-        string msg = "Tessellating ";
-        if (mesh->name == "")
-          msg += string_printf("%u/%u", (uint)(i + 1), (uint)total_tess_needed);
-        else
-          msg += string_printf(
-              "%s %u/%u", mesh->name.c_str(), (uint)(i + 1), (uint)total_tess_needed);
-
-        progress.set_status("Updating Mesh", msg);
-
         mesh->subd_params->camera = dicing_camera;
-        DiagSplit dsplit(*mesh->subd_params);
-        mesh->tessellate(&dsplit);
 
-        i++;
+        pool.push([mesh, &progress] {
+          if (progress.get_cancel()) {
+            return;
+          }
 
-        if (progress.get_cancel())
-          return;
+          DiagSplit dsplit(*mesh->subd_params);
+          mesh->tessellate(&dsplit);
+        });
       }
     }
+
+    pool.wait_work();
+
+    if (progress.get_cancel())
+      return;
   }
 
   /* Update images needed for true displacement. */
@@ -1308,8 +1327,9 @@ void GeometryManager::device_update(Device *device,
     scene->object_manager->device_update_flags(device, dscene, scene, progress, false);
   }
 
-  /* Device update. */
-  device_free(device, dscene);
+  /* Device update. Packed attribute arrays are kept, so that attributes which
+   * did not change do not have to be copied to the device again. */
+  device_free(device, dscene, false);
 
   mesh_calc_offset(scene);
   if (true_displacement_used) {
@@ -1348,7 +1368,7 @@ void GeometryManager::device_update(Device *device,
 
   /* Device re-update after displacement. */
   if (displacement_done) {
-    device_free(device, dscene);
+    device_free(device, dscene, false);
 
     device_update_attributes(device, dscene, scene, progress);
     if (progress.get_cancel())
@@ -1409,7 +1429,7 @@ void GeometryManager::device_update(Device *device,
   }
 }
 
-void GeometryManager::device_free(Device *device, DeviceScene *dscene)
+void GeometryManager::device_free(Device *device, DeviceScene *dscene, bool force_free)
 {
 #ifdef WITH_EMBREE
   if (dscene->data.bvh.scene) {
@@ -1438,10 +1458,13 @@ void GeometryManager::device_free(Device *device, DeviceScene *dscene)
   dscene->curve_keys.free();
   dscene->patches.free();
   dscene->attributes_map.free();
-  dscene->attributes_float.free();
-  dscene->attributes_float2.free();
-  dscene->attributes_float3.free();
-  dscene->attributes_uchar4.free();
+
+  if (force_free) {
+    dscene->attributes_float.free();
+    dscene->attributes_float2.free();
+    dscene->attributes_float3.free();
+    dscene->attributes_uchar4.free();
+  }
 
   /* Signal for shaders like displacement not to do ray tracing. */
   dscene->data.bvh.bvh_layout = BVH_LAYOUT_NONE;
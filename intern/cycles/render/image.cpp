@@ -299,6 +299,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   has_half_images = info.has_half_images;
+  has_sparse_volumes = info.has_sparse_volumes;
 }
 
 ImageManager::~ImageManager()
@@ -641,6 +642,80 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   return true;
 }
 
+bool ImageManager::file_load_sparse_image(Image *img, int texture_limit)
+{
+  /* Only OpenVDB grids are stored sparse, and only on devices that support it. */
+  if (!has_sparse_volumes || !img->loader->is_vdb_loader()) {
+    return false;
+  }
+
+  ImageDataType type = img->metadata.type;
+  if (type != IMAGE_DATA_TYPE_FLOAT && type != IMAGE_DATA_TYPE_FLOAT4) {
+    return false;
+  }
+
+  const size_t width = img->metadata.width;
+  const size_t height = img->metadata.height;
+  const size_t depth = img->metadata.depth;
+  const size_t max_size = max(max(width, height), depth);
+  if (max_size == 0 || (texture_limit > 0 && max_size > texture_limit)) {
+    /* Resizing is only implemented for dense images. */
+    return false;
+  }
+
+  VDBImageLoader *vdb_loader = static_cast<VDBImageLoader *>(img->loader);
+  vector<int> tile_offsets;
+  const size_t num_active_tiles = vdb_loader->load_sparse_tiles(tile_offsets, NULL);
+  if (num_active_tiles == 0) {
+    return false;
+  }
+
+  /* Tile offsets are stored as ints at the start of the data, followed by the tiles. */
+  const size_t voxel_size = (type == IMAGE_DATA_TYPE_FLOAT4) ? sizeof(float4) : sizeof(float);
+  const size_t offsets_size = divide_up(tile_offsets.size() * sizeof(int), voxel_size);
+  const size_t sparse_size = offsets_size + num_active_tiles * TEX_SPARSE_TILE_VOXELS;
+  const size_t dense_size = width * height * depth;
+
+  /* Dense lookups are cheaper, only go sparse when it saves a good amount of memory. */
+  if (sparse_size > dense_size * 3 / 4 || sparse_size > INT_MAX) {
+    return false;
+  }
+
+  size_t offset = offsets_size;
+  foreach (int &tile_offset, tile_offsets) {
+    if (tile_offset != -1) {
+      tile_offset = offset;
+      offset += TEX_SPARSE_TILE_VOXELS;
+    }
+  }
+
+  float *pixels;
+  {
+    thread_scoped_lock device_lock(device_mutex);
+    pixels = (float *)img->mem->alloc(sparse_size, 0);
+  }
+
+  if (pixels == NULL) {
+    return false;
+  }
+
+  memcpy(pixels, tile_offsets.data(), tile_offsets.size() * sizeof(int));
+  vdb_loader->load_sparse_tiles(tile_offsets, pixels);
+
+  /* Texture lookups use the dimensions of the full volume. */
+  img->mem->info.width = width;
+  img->mem->info.height = height;
+  img->mem->info.depth = depth;
+  img->mem->info.use_sparse_tiles = true;
+
+  VLOG(1) << "Loaded " << img->loader->name() << " as " << num_active_tiles << " of "
+          << tile_offsets.size() << " sparse tiles, "
+          << string_human_readable_size(sparse_size * voxel_size) << " instead of "
+          << string_human_readable_size(dense_size * voxel_size) << ".";
+
+  return true;
+}
+
 void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Progress *progress)
 {
   if (progress->get_cancel()) {
@@ -672,7 +747,10 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
   img->mem->info.transform_3d = img->metadata.transform_3d;
 
   /* Create new texture. */
-  if (type == IMAGE_DATA_TYPE_FLOAT4) {
+  if (file_load_sparse_image(img, texture_limit)) {
+    /* Volume stored as sparse tiles. */
+  }
+  else if (type == IMAGE_DATA_TYPE_FLOAT4) {
     if (!file_load_image<TypeDesc::FLOAT, float>(img, texture_limit)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
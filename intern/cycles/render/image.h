@@ -209,6 +209,7 @@ class ImageManager {
 
  private:
   bool has_half_images;
+  bool has_sparse_volumes;
 
   thread_mutex device_mutex;
   thread_mutex images_mutex;
@@ -225,6 +226,7 @@ class ImageManager {
 
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
+  bool file_load_sparse_image(Image *img, int texture_limit);
 
   void device_load_image(Device *device, Scene *scene, int slot, Progress *progress);
   void device_free_image(Device *device, int slot);
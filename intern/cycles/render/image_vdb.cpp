@@ -16,6 +16,9 @@
 
 #include "render/image_vdb.h"
 
+#include "util/util_foreach.h"
+#include "util/util_texture.h"
+
 #ifdef WITH_OPENVDB
 #  include <openvdb/openvdb.h>
 #  include <openvdb/tools/Dense.h>
@@ -23,6 +26,113 @@
 
 CCL_NAMESPACE_BEGIN
 
+#ifdef WITH_OPENVDB
+static void vdb_store_voxel(float *pixels, const size_t index, const float value)
+{
+  pixels[index] = (isfinite(value)) ? value : 0.0f;
+}
+
+static void vdb_store_voxel(float *pixels, const size_t index, const openvdb::Vec3f &value)
+{
+  /* Put all channels to 0 if either of them is not finite, same as for dense images. */
+  const bool is_finite = isfinite(value.x()) && isfinite(value.y()) && isfinite(value.z());
+  pixels[index * 4 + 0] = (is_finite) ? value.x() : 0.0f;
+  pixels[index * 4 + 1] = (is_finite) ? value.y() : 0.0f;
+  pixels[index * 4 + 2] = (is_finite) ? value.z() : 0.0f;
+  pixels[index * 4 + 3] = (is_finite) ? 1.0f : 0.0f;
+}
+
+static void vdb_mark_sparse_tiles(const openvdb::CoordBBox &bbox,
+                                  const openvdb::CoordBBox &node_bbox,
+                                  const openvdb::Coord &num_tiles,
+                                  vector<int> &tile_offsets)
+{
+  openvdb::CoordBBox overlap = node_bbox;
+  overlap.intersect(bbox);
+  if (overlap.empty()) {
+    return;
+  }
+
+  const openvdb::Coord min = (overlap.min() - bbox.min()) >> TEX_SPARSE_TILE_SHIFT;
+  const openvdb::Coord max = (overlap.max() - bbox.min()) >> TEX_SPARSE_TILE_SHIFT;
+
+  for (int z = min.z(); z <= max.z(); z++) {
+    for (int y = min.y(); y <= max.y(); y++) {
+      for (int x = min.x(); x <= max.x(); x++) {
+        tile_offsets[x + num_tiles.x() * (y + num_tiles.y() * z)] = 0;
+      }
+    }
+  }
+}
+
+template<typename GridType, typename DenseType>
+static size_t vdb_sparse_tiles(const GridType &grid,
+                               const openvdb::CoordBBox &bbox,
+                               vector<int> &tile_offsets,
+                               float *pixels)
+{
+  const openvdb::Coord num_tiles = (bbox.dim() + openvdb::Coord(TEX_SPARSE_TILE_SIZE - 1)) >>
+                                   TEX_SPARSE_TILE_SHIFT;
+
+  if (pixels == NULL) {
+    /* Empty tiles read as zero, grids with a different background value are stored dense. */
+    if (grid.background() != openvdb::zeroVal<typename GridType::ValueType>()) {
+      return 0;
+    }
+
+    /* Find tiles overlapping leaf nodes and active tiles of internal nodes. */
+    tile_offsets.clear();
+    tile_offsets.resize(((size_t)num_tiles.x()) * num_tiles.y() * num_tiles.z(), -1);
+
+    for (typename GridType::TreeType::LeafCIter iter = grid.tree().cbeginLeaf(); iter; ++iter) {
+      vdb_mark_sparse_tiles(bbox, iter->getNodeBoundingBox(), num_tiles, tile_offsets);
+    }
+
+    typename GridType::ValueOnCIter iter = grid.cbeginValueOn();
+    iter.setMaxDepth(GridType::ValueOnCIter::LEAF_DEPTH - 1);
+    for (; iter; ++iter) {
+      openvdb::CoordBBox node_bbox;
+      iter.getBoundingBox(node_bbox);
+      vdb_mark_sparse_tiles(bbox, node_bbox, num_tiles, tile_offsets);
+    }
+
+    size_t num_active = 0;
+    foreach (int offset, tile_offsets) {
+      num_active += (offset != -1);
+    }
+    return num_active;
+  }
+
+  /* Copy active tiles, including voxels outside the bounding box for padding. */
+  DenseType voxels[TEX_SPARSE_TILE_VOXELS];
+  size_t tile = 0;
+
+  for (int z = 0; z < num_tiles.z(); z++) {
+    for (int y = 0; y < num_tiles.y(); y++) {
+      for (int x = 0; x < num_tiles.x(); x++, tile++) {
+        const int offset = tile_offsets[tile];
+        if (offset < 0) {
+          continue;
+        }
+
+        const openvdb::Coord min = bbox.min() + openvdb::Coord(x * TEX_SPARSE_TILE_SIZE,
+                                                               y * TEX_SPARSE_TILE_SIZE,
+                                                               z * TEX_SPARSE_TILE_SIZE);
+        const openvdb::CoordBBox tile_bbox(min, min + openvdb::Coord(TEX_SPARSE_TILE_SIZE - 1));
+        openvdb::tools::Dense<DenseType, openvdb::tools::LayoutXYZ> dense(tile_bbox, voxels);
+        openvdb::tools::copyToDense(grid, dense, true);
+
+        for (int i = 0; i < TEX_SPARSE_TILE_VOXELS; i++) {
+          vdb_store_voxel(pixels, (size_t)offset + i, voxels[i]);
+        }
+      }
+    }
+  }
+
+  return tile;
+}
+#endif
+
 VDBImageLoader::VDBImageLoader(const string &grid_name) : grid_name(grid_name)
 {
 }
@@ -161,6 +271,58 @@ bool VDBImageLoader::load_pixels(const ImageMetaData &, void *pixels, const size
 #endif
 }
 
+size_t VDBImageLoader::load_sparse_tiles(vector<int> &tile_offsets, float *pixels)
+{
+#ifdef WITH_OPENVDB
+  if (!grid) {
+    return 0;
+  }
+
+  if (grid->isType<openvdb::FloatGrid>()) {
+    return vdb_sparse_tiles<openvdb::FloatGrid, float>(
+        *openvdb::gridConstPtrCast<openvdb::FloatGrid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::Vec3fGrid>()) {
+    return vdb_sparse_tiles<openvdb::Vec3fGrid, openvdb::Vec3f>(
+        *openvdb::gridConstPtrCast<openvdb::Vec3fGrid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::BoolGrid>()) {
+    return vdb_sparse_tiles<openvdb::BoolGrid, float>(
+        *openvdb::gridConstPtrCast<openvdb::BoolGrid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::DoubleGrid>()) {
+    return vdb_sparse_tiles<openvdb::DoubleGrid, float>(
+        *openvdb::gridConstPtrCast<openvdb::DoubleGrid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::Int32Grid>()) {
+    return vdb_sparse_tiles<openvdb::Int32Grid, float>(
+        *openvdb::gridConstPtrCast<openvdb::Int32Grid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::Int64Grid>()) {
+    return vdb_sparse_tiles<openvdb::Int64Grid, float>(
+        *openvdb::gridConstPtrCast<openvdb::Int64Grid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::Vec3IGrid>()) {
+    return vdb_sparse_tiles<openvdb::Vec3IGrid, openvdb::Vec3f>(
+        *openvdb::gridConstPtrCast<openvdb::Vec3IGrid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::Vec3dGrid>()) {
+    return vdb_sparse_tiles<openvdb::Vec3dGrid, openvdb::Vec3f>(
+        *openvdb::gridConstPtrCast<openvdb::Vec3dGrid>(grid), bbox, tile_offsets, pixels);
+  }
+  else if (grid->isType<openvdb::MaskGrid>()) {
+    return vdb_sparse_tiles<openvdb::MaskGrid, float>(
+        *openvdb::gridConstPtrCast<openvdb::MaskGrid>(grid), bbox, tile_offsets, pixels);
+  }
+
+  return 0;
+#else
+  (void)tile_offsets;
+  (void)pixels;
+  return 0;
+#endif
+}
+
 string VDBImageLoader::name() const
 {
   return grid_name;
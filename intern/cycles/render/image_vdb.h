@@ -45,6 +45,12 @@ class VDBImageLoader : public ImageLoader {
 
   virtual bool is_vdb_loader() const override;
 
+  /* Sparse tile storage, see TEX_SPARSE_TILE_SIZE. Without pixels, sets the offset of tiles
+   * containing active voxels to 0 and of empty tiles to -1, and returns the number of active
+   * tiles, or 0 when the grid can not be stored sparse. With pixels, fills the voxels of all
+   * tiles with a non-negative offset. */
+  size_t load_sparse_tiles(vector<int> &tile_offsets, float *pixels);
+
 #ifdef WITH_OPENVDB
   openvdb::GridBase::ConstPtr get_grid();
 #endif
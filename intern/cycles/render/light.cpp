@@ -315,7 +315,7 @@ void LightManager::device_update_distribution(Device *,
                            mesh->used_shaders[shader_index] :
                            scene->default_surface;
 
-      if (shader->use_mis && shader->has_surface_emission) {
+      if (shader->use_mis && shader->has_surface_emission && shader->emission_estimate > 0.0f) {
         num_triangles++;
       }
     }
@@ -371,7 +371,7 @@ void LightManager::device_update_distribution(Device *,
                            mesh->used_shaders[shader_index] :
                            scene->default_surface;
 
-      if (shader->use_mis && shader->has_surface_emission) {
+      if (shader->use_mis && shader->has_surface_emission && shader->emission_estimate > 0.0f) {
         distribution[offset].totarea = totarea;
         distribution[offset].prim = i + mesh->prim_offset;
         distribution[offset].mesh_light.shader_flag = shader_flag;
@@ -392,7 +392,9 @@ void LightManager::device_update_distribution(Device *,
           p3 = transform_point(&tfm, p3);
         }
 
-        totarea += triangle_area(p1, p2, p3);
+        /* Weight by estimated emission strength, so that bright triangles are sampled
+         * more often than dim ones. */
+        totarea += triangle_area(p1, p2, p3) * shader->emission_estimate;
       }
     }
 
@@ -128,6 +128,9 @@ class DeviceScene {
   /* ies lights */
   device_vector<float> ies_lights;
 
+  /* bake */
+  device_vector<uint2> bake_objects;
+
   KernelData data;
 
   DeviceScene(Device *device);
@@ -29,11 +29,15 @@
 #include "render/scene.h"
 #include "render/session.h"
 
+#include "util/util_debug.h"
 #include "util/util_foreach.h"
 #include "util/util_function.h"
+#include "util/util_hash.h"
 #include "util/util_logging.h"
 #include "util/util_math.h"
+#include "util/util_murmurhash.h"
 #include "util/util_opengl.h"
+#include "util/util_path.h"
 #include "util/util_task.h"
 #include "util/util_time.h"
 
@@ -90,6 +94,8 @@ Session::Session(const SessionParams &params_)
   gpu_draw_ready = false;
   gpu_need_display_buffer_update = false;
   pause = false;
+
+  tile_checkpoint_hash = 0;
 }
 
 Session::~Session()
@@ -379,6 +385,20 @@ bool Session::draw_cpu(BufferParams &buffer_params, DeviceDrawParams &draw_param
 }
 
 bool Session::acquire_tile(RenderTile &rtile, Device *tile_device, uint tile_types)
+{
+  while (acquire_next_tile(rtile, tile_device, tile_types)) {
+    /* Tiles finished by an interrupted render are read back instead of rendered again. */
+    if (!(rtile.task == RenderTile::PATH_TRACE && read_tile_checkpoint(rtile))) {
+      return true;
+    }
+
+    release_tile(rtile, false);
+  }
+
+  return false;
+}
+
+bool Session::acquire_next_tile(RenderTile &rtile, Device *tile_device, uint tile_types)
 {
   if (progress.get_cancel()) {
     if (params.progressive_refine == false) {
@@ -502,6 +522,11 @@ void Session::update_tile_sample(RenderTile &rtile)
 
 void Session::release_tile(RenderTile &rtile, const bool need_denoise)
 {
+  /* Write checkpoint before taking the lock, other threads should not wait for file I/O. */
+  if (rtile.task == RenderTile::PATH_TRACE) {
+    write_tile_checkpoint(rtile);
+  }
+
   thread_scoped_lock tile_lock(tile_mutex);
 
   progress.add_finished_tile(rtile.task == RenderTile::DENOISE);
@@ -532,6 +557,153 @@ void Session::release_tile(RenderTile &rtile, const bool need_denoise)
   denoising_cond.notify_all();
 }
 
+bool Session::use_tile_checkpoints()
+{
+  /* Only for final renders where every tile has its own buffer and is rendered
+   * with all samples at once. */
+  return !params.checkpoint_path.empty() && params.background && !params.progressive_refine &&
+         !buffers && !read_bake_tile_cb && !tile_manager.schedule_denoising &&
+         tile_manager.state.resolution_divider == 1;
+}
+
+/* Hashes only x, y and z, the fourth component of float3 may be uninitialized. */
+static uint hash_float3_components(uint hash, const float3 &v)
+{
+  return hash_uint4(hash, __float_as_uint(v.x), __float_as_uint(v.y), __float_as_uint(v.z));
+}
+
+void Session::update_tile_checkpoint_hash()
+{
+  /* Render settings, camera and film are in the kernel data, which is cleared when the scene
+   * is created. The BVH is skipped since it holds pointers and follows from the geometry. */
+  const KernelData &data = scene->dscene.data;
+  uint hash = util_murmur_hash3(&data.cam, sizeof(data.cam), 0);
+  hash = util_murmur_hash3(&data.film, sizeof(data.film), hash);
+  hash = util_murmur_hash3(&data.background, sizeof(data.background), hash);
+  hash = util_murmur_hash3(&data.integrator, sizeof(data.integrator), hash);
+  hash = util_murmur_hash3(&data.tables, sizeof(data.tables), hash);
+
+  /* Shader nodes are fully written by the compiler, other device arrays contain padding that
+   * is not initialized, so objects, meshes and lights are hashed from the scene instead. */
+  device_vector<int4> &svm_nodes = scene->dscene.svm_nodes;
+  hash = util_murmur_hash3(svm_nodes.data(), svm_nodes.size() * sizeof(int4), hash);
+
+  foreach (const Object *object, scene->objects) {
+    hash = hash_uint2(hash, hash_string(object->name.c_str()));
+    hash = util_murmur_hash3(&object->tfm, sizeof(object->tfm), hash);
+  }
+
+  foreach (const Geometry *geom, scene->geometry) {
+    hash = hash_uint2(hash, geom->type);
+    if (geom->type == Geometry::MESH) {
+      const Mesh *mesh = static_cast<const Mesh *>(geom);
+      hash = hash_uint2(hash, mesh->num_triangles());
+      for (size_t i = 0; i < mesh->verts.size(); i++) {
+        hash = hash_float3_components(hash, mesh->verts[i]);
+      }
+    }
+  }
+
+  foreach (const Light *light, scene->lights) {
+    hash = hash_float3_components(hash, light->co);
+    hash = hash_float3_components(hash, light->dir);
+    hash = hash_uint2(hash, __float_as_uint(light->size));
+  }
+
+  tile_checkpoint_hash = hash;
+}
+
+string Session::tile_checkpoint_filepath(const RenderTile &rtile)
+{
+  /* The checkpoint directory is per view layer and frame. The seed differs between views and
+   * chunks of resumable renders, include it along with the tile region, sample range, buffer
+   * layout and scene hash to avoid picking up tiles of other renders. */
+  const BufferParams &buffer_params = rtile.buffers->params;
+  uint layout_hash = hash_uint2(buffer_params.full_width, buffer_params.full_height);
+  foreach (const Pass &pass, buffer_params.passes) {
+    layout_hash = hash_uint2(layout_hash, hash_uint2(pass.type, pass.components));
+  }
+  layout_hash = hash_uint2(layout_hash,
+                           (buffer_params.denoising_data_pass ? 1 : 0) |
+                               (buffer_params.denoising_clean_pass ? 2 : 0) |
+                               (buffer_params.denoising_prefiltered_pass ? 4 : 0));
+
+  return path_join(params.checkpoint_path,
+                   string_printf("tile_%d_%d_%d_%d_%d_%d_%u_%08x_%08x.bin",
+                                 rtile.x,
+                                 rtile.y,
+                                 rtile.w,
+                                 rtile.h,
+                                 rtile.start_sample,
+                                 rtile.num_samples,
+                                 scene->integrator->seed,
+                                 layout_hash,
+                                 tile_checkpoint_hash));
+}
+
+bool Session::read_tile_checkpoint(RenderTile &rtile)
+{
+  if (!use_tile_checkpoints()) {
+    return false;
+  }
+
+  const string filepath = tile_checkpoint_filepath(rtile);
+  if (!path_exists(filepath)) {
+    return false;
+  }
+
+  device_vector<float> &buffer = rtile.buffers->buffer;
+  const size_t buffer_size = buffer.size() * sizeof(float);
+
+  /* Files written only partially or with different passes are ignored. */
+  vector<uint8_t> binary;
+  if (path_file_size(filepath) != buffer_size || !path_read_binary(filepath, binary) ||
+      binary.size() != buffer_size) {
+    VLOG(1) << "Ignoring tile checkpoint " << filepath << ", size does not match.";
+    return false;
+  }
+
+  memcpy(buffer.data(), binary.data(), buffer_size);
+  buffer.copy_to_device();
+
+  rtile.sample = rtile.start_sample + rtile.num_samples;
+  progress.add_samples((uint64_t)rtile.w * rtile.h * rtile.num_samples, rtile.sample);
+
+  VLOG(2) << "Resumed tile from checkpoint " << filepath << ".";
+
+  return true;
+}
+
+void Session::write_tile_checkpoint(RenderTile &rtile)
+{
+  /* Skip tiles that were cancelled before all samples were rendered. */
+  if (!use_tile_checkpoints() || rtile.sample != rtile.start_sample + rtile.num_samples) {
+    return;
+  }
+
+  device_vector<float> &buffer = rtile.buffers->buffer;
+  const size_t buffer_size = buffer.size() * sizeof(float);
+
+  /* Tiles that were resumed from a checkpoint do not need to be written again. */
+  const string filepath = tile_checkpoint_filepath(rtile);
+  if (path_exists(filepath) && path_file_size(filepath) == buffer_size) {
+    return;
+  }
+
+  rtile.buffers->copy_from_device();
+
+  const uint8_t *data = (const uint8_t *)buffer.data();
+  const vector<uint8_t> binary(data, data + buffer_size);
+
+  /* Write to a temporary file first, so an interrupted write never leaves a checkpoint with
+   * the right size but incomplete contents. */
+  const string temp_filepath = filepath + ".tmp";
+  if (!path_write_binary(temp_filepath, binary) || !path_rename(temp_filepath, filepath)) {
+    VLOG(1) << "Failed to write tile checkpoint " << filepath << ".";
+    path_remove(temp_filepath);
+  }
+}
+
 void Session::map_neighbor_tiles(RenderTileNeighbors &neighbors, Device *tile_device)
 {
   thread_scoped_lock tile_lock(tile_mutex);
@@ -810,6 +982,18 @@ void Session::reset_(BufferParams &buffer_params, int samples)
     }
   }
 
+  /* For final renders on the CPU every thread works on its own tile, split the last
+   * tiles so that no threads are left idle near the end of the render. The split depends on
+   * thread count and timing, so it is not done for deterministic renders, or when tiles are
+   * checkpointed since the tiles of a resumed render would not match. */
+  if (params.background && params.device.type == DEVICE_CPU && !DebugFlags().cpu.deterministic &&
+      params.checkpoint_path.empty()) {
+    tile_manager.split_tiles_threshold = TaskScheduler::num_threads();
+  }
+  else {
+    tile_manager.split_tiles_threshold = 0;
+  }
+
   tile_manager.reset(buffer_params, samples);
   progress.reset_sample();
 
@@ -941,6 +1125,9 @@ bool Session::update_scene()
 
   bool kernel_switch_needed = false;
   if (scene->update(progress, kernel_switch_needed)) {
+    if (!params.checkpoint_path.empty()) {
+      update_tile_checkpoint_hash();
+    }
     if (kernel_switch_needed) {
       reset(tile_manager.params, params.samples);
     }
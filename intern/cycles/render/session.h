@@ -71,6 +71,11 @@ class SessionParams {
 
   ShadingSystem shadingsystem;
 
+  /* Directory to store finished tiles of final renders in. Tiles found there when
+   * rendering again with the same settings are read back instead of being rendered,
+   * so that an interrupted render can be resumed. Empty to disable. */
+  string checkpoint_path;
+
   function<bool(const uchar *pixels, int width, int height, int channels)> write_render_cb;
 
   SessionParams()
@@ -194,9 +199,16 @@ class Session {
   bool render_need_denoise(bool &delayed);
 
   bool acquire_tile(RenderTile &tile, Device *tile_device, uint tile_types);
+  bool acquire_next_tile(RenderTile &tile, Device *tile_device, uint tile_types);
   void update_tile_sample(RenderTile &tile);
   void release_tile(RenderTile &tile, const bool need_denoise);
 
+  bool use_tile_checkpoints();
+  void update_tile_checkpoint_hash();
+  string tile_checkpoint_filepath(const RenderTile &tile);
+  bool read_tile_checkpoint(RenderTile &tile);
+  void write_tile_checkpoint(RenderTile &tile);
+
   void map_neighbor_tiles(RenderTileNeighbors &neighbors, Device *tile_device);
   void unmap_neighbor_tiles(RenderTileNeighbors &neighbors, Device *tile_device);
 
@@ -218,6 +230,9 @@ class Session {
   thread_mutex display_mutex;
   thread_condition_variable denoising_cond;
 
+  /* Hash of the scene and render settings, for tile checkpoints. */
+  uint tile_checkpoint_hash;
+
   double reset_time;
   double last_update_time;
   double last_display_time;
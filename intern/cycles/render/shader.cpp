@@ -210,6 +210,7 @@ Shader::Shader() : Node(node_type)
   has_integrator_dependency = false;
   has_volume_connected = false;
   prev_volume_step_rate = 0.0f;
+  emission_estimate = 0.0f;
 
   displacement_method = DISPLACE_BUMP;
 
@@ -271,6 +272,109 @@ bool Shader::is_constant_emission(float3 *emission)
   return true;
 }
 
+static float3 output_estimate_emission(ShaderOutput *output)
+{
+  /* Only a few common nodes are understood, anything else that might emit is
+   * assumed to have unit strength. */
+  ShaderNode *node = output->parent;
+
+  if (node->type == EmissionNode::node_type || node->type == BackgroundNode::node_type) {
+    ShaderInput *color_in = node->input("Color");
+    ShaderInput *strength_in = node->input("Strength");
+
+    /* Linked colors are assumed to be textures in the 0..1 range. */
+    float3 estimate = (color_in->link) ? make_float3(1.0f, 1.0f, 1.0f) :
+                                         node->get_float3(color_in->socket_type);
+
+    if (strength_in->link) {
+      estimate *= output_estimate_emission(strength_in->link);
+    }
+    else {
+      estimate *= node->get_float(strength_in->socket_type);
+    }
+
+    return estimate;
+  }
+  else if (node->type == AddClosureNode::node_type) {
+    ShaderInput *closure1_in = node->input("Closure1");
+    ShaderInput *closure2_in = node->input("Closure2");
+
+    float3 estimate = make_float3(0.0f, 0.0f, 0.0f);
+    if (closure1_in->link) {
+      estimate += output_estimate_emission(closure1_in->link);
+    }
+    if (closure2_in->link) {
+      estimate += output_estimate_emission(closure2_in->link);
+    }
+
+    return estimate;
+  }
+  else if (node->type == MixClosureNode::node_type) {
+    ShaderInput *fac_in = node->input("Fac");
+    ShaderInput *closure1_in = node->input("Closure1");
+    ShaderInput *closure2_in = node->input("Closure2");
+
+    const float3 estimate1 = (closure1_in->link) ? output_estimate_emission(closure1_in->link) :
+                                                   make_float3(0.0f, 0.0f, 0.0f);
+    const float3 estimate2 = (closure2_in->link) ? output_estimate_emission(closure2_in->link) :
+                                                   make_float3(0.0f, 0.0f, 0.0f);
+
+    if (fac_in->link) {
+      return estimate1 + estimate2;
+    }
+
+    const float fac = node->get_float(fac_in->socket_type);
+    return (1.0f - fac) * estimate1 + fac * estimate2;
+  }
+  else if (output->type() == SocketType::CLOSURE) {
+    /* OSL script nodes don't report emission, it is only known from their bytecode. */
+    const bool may_emit = node->has_surface_emission() ||
+                          node->special_type == SHADER_SPECIAL_TYPE_OSL;
+    float3 estimate = (may_emit) ? make_float3(1.0f, 1.0f, 1.0f) :
+                                   make_float3(0.0f, 0.0f, 0.0f);
+
+    foreach (ShaderInput *input, node->inputs) {
+      if (input->type() == SocketType::CLOSURE && input->link) {
+        estimate += output_estimate_emission(input->link);
+      }
+    }
+
+    return estimate;
+  }
+
+  /* Non-closure outputs feeding into a strength, value unknown. */
+  return make_float3(1.0f, 1.0f, 1.0f);
+}
+
+void Shader::estimate_emission()
+{
+  emission_estimate = 0.0f;
+
+  if (!has_surface_emission) {
+    return;
+  }
+
+  /* Emission that can't be traced through the graph is assumed to have unit strength,
+   * so the shader is never excluded from light sampling. */
+  emission_estimate = 1.0f;
+
+  if (graph == NULL) {
+    return;
+  }
+
+  ShaderInput *surf = graph->output()->input("Surface");
+  if (surf->link == NULL) {
+    return;
+  }
+
+  const float estimate = average(fabs(output_estimate_emission(surf->link)));
+
+  /* The graph found no emitting closure, though the shader was flagged as emitting. */
+  if (estimate > 0.0f) {
+    emission_estimate = estimate;
+  }
+}
+
 void Shader::set_graph(ShaderGraph *graph_)
 {
   /* do this here already so that we can detect if mesh or object attributes
@@ -564,6 +668,8 @@ void ShaderManager::device_update_common(Device *device,
     if (shader->is_constant_emission(&constant_emission))
       flag |= SD_HAS_CONSTANT_EMISSION;
 
+    shader->estimate_emission();
+
     uint32_t cryptomatte_id = util_murmur_hash3(shader->name.c_str(), shader->name.length(), 0);
 
     /* regular shader */
@@ -572,6 +678,7 @@ void ShaderManager::device_update_common(Device *device,
     kshader->constant_emission[0] = constant_emission.x;
     kshader->constant_emission[1] = constant_emission.y;
     kshader->constant_emission[2] = constant_emission.z;
+    kshader->emission_estimate = shader->emission_estimate;
     kshader->cryptomatte_id = util_hash_to_float(cryptomatte_id);
     kshader++;
 
@@ -122,6 +122,10 @@ class Shader : public Node {
   bool has_volume_attribute_dependency;
   bool has_integrator_dependency;
 
+  /* Rough estimate of the surface emission strength, used to pick emissive triangles
+   * for light sampling. Zero only if the shader is known to emit no light. */
+  float emission_estimate;
+
   /* displacement */
   DisplacementMethod displacement_method;
 
@@ -149,6 +153,9 @@ class Shader : public Node {
    * then used for speeding up light evaluation. */
   bool is_constant_emission(float3 *emission);
 
+  /* Updates emission_estimate from the compiled shader graph. */
+  void estimate_emission();
+
   void set_graph(ShaderGraph *graph);
   void tag_update(Scene *scene);
   void tag_used(Scene *scene);
@@ -102,6 +102,7 @@ TileManager::TileManager(bool progressive_,
   start_resolution = start_resolution_;
   pixel_size = pixel_size_;
   slice_overlap = 0;
+  split_tiles_threshold = 0;
   num_samples = num_samples_;
   num_devices = num_devices_;
   preserve_tile_device = preserve_tile_device_;
@@ -154,6 +155,7 @@ void TileManager::reset(BufferParams &params_, int num_samples_)
   state.buffer = BufferParams();
   state.sample = range_start_sample - 1;
   state.num_tiles = 0;
+  state.num_grid_tiles = 0;
   state.num_samples = 0;
   state.resolution_divider = get_divider(params.width, params.height, start_resolution);
   state.render_tiles.clear();
@@ -381,6 +383,14 @@ void TileManager::set_tiles()
   int image_h = max(1, params.height / resolution);
 
   state.num_tiles = gen_tiles(!background);
+  state.num_grid_tiles = state.num_tiles;
+
+  /* Tiles are referenced by pointer while they are being rendered, so make sure splitting
+   * them later on never reallocates the tile array. Every grid tile keeps its entry and adds
+   * up to four split tiles. */
+  if (split_tiles_threshold > 0) {
+    state.tiles.reserve(state.num_tiles * 5);
+  }
 
   state.buffer.width = image_w;
   state.buffer.height = image_h;
@@ -495,6 +505,68 @@ bool TileManager::finish_tile(const int index, const bool need_denoise, bool &de
   }
 }
 
+/* Minimum width and height of tiles created by splitting. */
+#define SPLIT_TILE_MIN_SIZE 16
+
+bool TileManager::can_split_tile(int index)
+{
+  /* Splitting changes the tile layout, which only works when tiles have their own buffers
+   * and no neighbor relations have to be maintained for denoising. */
+  if (split_tiles_threshold <= 0 || !background || progressive || schedule_denoising ||
+      slice_overlap != 0) {
+    return false;
+  }
+
+  /* Only split grid tiles, tiles which were split already are small enough. */
+  if (index >= state.num_grid_tiles) {
+    return false;
+  }
+
+  const Tile &tile = state.tiles[index];
+  if (tile.w < 2 * SPLIT_TILE_MIN_SIZE && tile.h < 2 * SPLIT_TILE_MIN_SIZE) {
+    return false;
+  }
+
+  size_t num_queued = 0;
+  foreach (const list<int> &render_tiles, state.render_tiles) {
+    num_queued += render_tiles.size();
+  }
+
+  return num_queued < (size_t)split_tiles_threshold;
+}
+
+void TileManager::split_tile(int index, int logical_device)
+{
+  Tile parent = state.tiles[index];
+
+  const int num_x = (parent.w >= 2 * SPLIT_TILE_MIN_SIZE) ? 2 : 1;
+  const int num_y = (parent.h >= 2 * SPLIT_TILE_MIN_SIZE) ? 2 : 1;
+  const int split_w = parent.w / num_x;
+  const int split_h = parent.h / num_y;
+
+  /* The parent tile itself is never rendered, its area is covered by the new tiles. */
+  state.tiles[index].state = Tile::DONE;
+
+  list<int> &render_tiles = state.render_tiles[logical_device];
+
+  for (int y = num_y - 1; y >= 0; y--) {
+    for (int x = num_x - 1; x >= 0; x--) {
+      const int split_x = parent.x + x * split_w;
+      const int split_y = parent.y + y * split_h;
+      const int w = (x == num_x - 1) ? parent.x + parent.w - split_x : split_w;
+      const int h = (y == num_y - 1) ? parent.y + parent.h - split_y : split_h;
+
+      assert(state.tiles.size() < state.tiles.capacity());
+      const int split_index = state.tiles.size();
+      state.tiles.push_back(
+          Tile(split_index, split_x, split_y, w, h, parent.device, Tile::RENDER));
+      render_tiles.push_front(split_index);
+    }
+  }
+
+  state.num_tiles += num_x * num_y - 1;
+}
+
 bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
 {
   /* Preserve device if requested, unless this is a separate denoising device that just wants to
@@ -544,6 +616,14 @@ bool TileManager::next_tile(Tile *&tile, int device, uint tile_types)
 
       tile_index = state.render_tiles[logical_device].front();
       state.render_tiles[logical_device].pop_front();
+
+      /* Near the end of the render, hand out smaller pieces of work so that all threads
+       * keep busy until the last pixels are done. */
+      if (can_split_tile(tile_index)) {
+        split_tile(tile_index, logical_device);
+        tile_index = state.render_tiles[logical_device].front();
+        state.render_tiles[logical_device].pop_front();
+      }
       break;
     }
 
@@ -77,6 +77,10 @@ class TileManager {
     int resolution_divider;
     int num_tiles;
 
+    /* Number of tiles in the regular tile grid, tiles beyond this index were created by
+     * splitting grid tiles near the end of the render. */
+    int num_grid_tiles;
+
     /* Total samples over all pixels: Generally num_samples*num_pixels,
      * but can be higher due to the initial resolution division for previews. */
     uint64_t total_pixel_samples;
@@ -91,6 +95,11 @@ class TileManager {
   int num_samples;
   int slice_overlap;
 
+  /* Once fewer tiles than this are left to be rendered, split the remaining tiles into
+   * smaller ones as they are acquired, so that threads don't sit idle while the last few
+   * expensive tiles finish. Typically set to the number of render threads, 0 disables. */
+  int split_tiles_threshold;
+
   TileManager(bool progressive,
               int num_samples,
               int2 tile_size,
@@ -165,6 +174,10 @@ class TileManager {
   /* Generate tile list, return number of tiles. */
   int gen_tiles(bool sliced);
   void gen_render_tiles();
+
+  /* Split a tile that is about to be rendered, queuing the other parts. */
+  bool can_split_tile(int index);
+  void split_tile(int index, int logical_device);
 };
 
 CCL_NAMESPACE_END
@@ -432,17 +432,46 @@ static openvdb::GridBase::ConstPtr openvdb_grid_from_device_texture(device_textu
 {
   using ValueType = typename GridType::ValueType;
 
-  openvdb::CoordBBox dense_bbox(0,
-                                0,
-                                0,
-                                image_memory->data_width - 1,
-                                image_memory->data_height - 1,
-                                image_memory->data_depth - 1);
-  openvdb::tools::Dense<ValueType, openvdb::tools::MemoryLayout::LayoutXYZ> dense(
-      dense_bbox, static_cast<ValueType *>(image_memory->host_pointer));
+  const int width = image_memory->info.width;
+  const int height = image_memory->info.height;
+  const int depth = image_memory->info.depth;
 
   typename GridType::Ptr sparse = GridType::create(ValueType(0.0f));
-  openvdb::tools::copyFromDense(dense, *sparse, ValueType(volume_clipping));
+
+  if (image_memory->info.use_sparse_tiles) {
+    /* Copy non-empty tiles one by one. */
+    const int *tile_offsets = static_cast<const int *>(image_memory->host_pointer);
+    ValueType *voxels = static_cast<ValueType *>(image_memory->host_pointer);
+    const int tiles_x = divide_up(width, TEX_SPARSE_TILE_SIZE);
+    const int tiles_y = divide_up(height, TEX_SPARSE_TILE_SIZE);
+    const int tiles_z = divide_up(depth, TEX_SPARSE_TILE_SIZE);
+    int tile = 0;
+
+    for (int z = 0; z < tiles_z; z++) {
+      for (int y = 0; y < tiles_y; y++) {
+        for (int x = 0; x < tiles_x; x++, tile++) {
+          const int offset = tile_offsets[tile];
+          if (offset < 0) {
+            continue;
+          }
+
+          const openvdb::Coord min(
+              x * TEX_SPARSE_TILE_SIZE, y * TEX_SPARSE_TILE_SIZE, z * TEX_SPARSE_TILE_SIZE);
+          openvdb::CoordBBox tile_bbox(min, min + openvdb::Coord(TEX_SPARSE_TILE_SIZE - 1));
+          openvdb::tools::Dense<ValueType, openvdb::tools::MemoryLayout::LayoutXYZ> dense(
+              tile_bbox, voxels + offset);
+          openvdb::tools::copyFromDense(dense, *sparse, ValueType(volume_clipping));
+        }
+      }
+    }
+  }
+  else {
+    openvdb::CoordBBox dense_bbox(0, 0, 0, width - 1, height - 1, depth - 1);
+    openvdb::tools::Dense<ValueType, openvdb::tools::MemoryLayout::LayoutXYZ> dense(
+        dense_bbox, static_cast<ValueType *>(image_memory->host_pointer));
+
+    openvdb::tools::copyFromDense(dense, *sparse, ValueType(volume_clipping));
+  }
 
   /* #copyFromDense will remove any leaf node that contains constant data and replace it with a
    * tile, however, we need to preserve the leaves in order to generate the mesh, so re-voxelize
@@ -451,9 +480,7 @@ static openvdb::GridBase::ConstPtr openvdb_grid_from_device_texture(device_textu
   sparse->tree().voxelizeActiveTiles();
 
   /* Compute index to world matrix. */
-  float3 voxel_size = make_float3(1.0f / image_memory->data_width,
-                                  1.0f / image_memory->data_height,
-                                  1.0f / image_memory->data_depth);
+  float3 voxel_size = make_float3(1.0f / width, 1.0f / height, 1.0f / depth);
 
   transform_3d = transform_inverse(transform_3d);
 
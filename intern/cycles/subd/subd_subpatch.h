@@ -28,6 +28,7 @@ class Subpatch {
  public:
   class Patch *patch; /* Patch this is a subpatch of. */
   int inner_grid_vert_offset;
+  int triangle_offset;
 
   struct edge_t {
     int T;
@@ -31,6 +31,7 @@ DebugFlags::CPU::CPU()
       sse41(true),
       sse3(true),
       sse2(true),
+      deterministic(false),
       bvh_layout(BVH_LAYOUT_AUTO),
       split_kernel(false)
 {
@@ -57,6 +58,8 @@ void DebugFlags::CPU::reset()
 #undef STRINGIFY
 #undef CHECK_CPU_FLAGS
 
+  deterministic = (getenv("CYCLES_CPU_DETERMINISTIC") != NULL);
+
   bvh_layout = BVH_LAYOUT_AUTO;
 
   split_kernel = false;
@@ -142,6 +145,7 @@ std::ostream &operator<<(std::ostream &os, DebugFlagsConstRef debug_flags)
      << "  SSE4.1     : " << string_from_bool(debug_flags.cpu.sse41) << "\n"
      << "  SSE3       : " << string_from_bool(debug_flags.cpu.sse3) << "\n"
      << "  SSE2       : " << string_from_bool(debug_flags.cpu.sse2) << "\n"
+     << "  Determinism: " << string_from_bool(debug_flags.cpu.deterministic) << "\n"
      << "  BVH layout : " << bvh_layout_name(debug_flags.cpu.bvh_layout) << "\n"
      << "  Split      : " << string_from_bool(debug_flags.cpu.split_kernel) << "\n";
 
@@ -49,6 +49,13 @@ class DebugFlags {
     bool sse3;
     bool sse2;
 
+    /* Render bit-identical results regardless of the machine and number of
+     * threads, for regression testing. This limits the kernel to SSE4.1 so
+     * no fused multiply-add is used, and uses the BVH2 layout instead of
+     * Embree since its traversal code depends on the host instruction set.
+     */
+    bool deterministic;
+
     /* Check functions to see whether instructions up to the given one
      * are allowed for use.
      */
@@ -58,7 +65,7 @@ class DebugFlags {
     }
     bool has_avx()
     {
-      return has_sse41() && avx;
+      return has_sse41() && avx && !deterministic;
     }
     bool has_sse41()
     {
@@ -739,6 +739,18 @@ bool path_remove(const string &path)
   return remove(path.c_str()) == 0;
 }
 
+/* Replaces an existing file at the destination. */
+bool path_rename(const string &from, const string &to)
+{
+#ifdef _WIN32
+  return MoveFileExW(string_to_wstring(from).c_str(),
+                     string_to_wstring(to).c_str(),
+                     MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+  return rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
+
 struct SourceReplaceState {
   typedef map<string, string> ProcessedMapping;
   /* Base director for all relative include headers. */
@@ -33,6 +33,13 @@ CCL_NAMESPACE_BEGIN
 /* Texture type. */
 #define kernel_tex_type(tex) (tex & IMAGE_DATA_TYPE_MASK)
 
+/* Sparse 3D textures only store tiles of TEX_SPARSE_TILE_SIZE^3 voxels that contain data.
+ * The data starts with one int per tile, giving the offset of the tile voxels in the data
+ * or -1 for empty tiles, followed by the voxels of the non-empty tiles. */
+#define TEX_SPARSE_TILE_SHIFT 3
+#define TEX_SPARSE_TILE_SIZE (1 << TEX_SPARSE_TILE_SHIFT)
+#define TEX_SPARSE_TILE_VOXELS (TEX_SPARSE_TILE_SIZE * TEX_SPARSE_TILE_SIZE * TEX_SPARSE_TILE_SIZE)
+
 /* Interpolation types for textures
  * cuda also use texture space to store other objects */
 typedef enum InterpolationType {
@@ -103,6 +110,8 @@ typedef struct TextureInfo {
   uint width, height, depth;
   /* Transform for 3D textures. */
   uint use_transform_3d;
+  /* Sparse tile storage for 3D textures, CPU only. */
+  uint use_sparse_tiles;
   Transform transform_3d;
 } TextureInfo;
 
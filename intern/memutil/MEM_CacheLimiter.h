@@ -64,6 +64,7 @@ template<class T> class MEM_CacheLimiter;
 extern "C" {
 void MEM_CacheLimiter_set_maximum(size_t m);
 size_t MEM_CacheLimiter_get_maximum();
+size_t MEM_CacheLimiter_get_external_memory();
 void MEM_CacheLimiter_set_disabled(bool disabled);
 bool MEM_CacheLimiter_is_disabled(void);
 };
@@ -201,6 +202,11 @@ template<class T> class MEM_CacheLimiter {
 
     mem_in_use = get_memory_in_use();
 
+    /* Without data size function all allocated memory is measured, external included. */
+    if (data_size_func) {
+      mem_in_use += MEM_CacheLimiter_get_external_memory();
+    }
+
     if (mem_in_use <= max) {
       return;
     }
@@ -48,10 +48,22 @@ typedef bool (*MEM_CacheLimiter_ItemDestroyable_Func)(void *);
 #ifndef __MEM_CACHELIMITER_H__
 void MEM_CacheLimiter_set_maximum(size_t m);
 size_t MEM_CacheLimiter_get_maximum(void);
+size_t MEM_CacheLimiter_get_external_memory(void);
 void MEM_CacheLimiter_set_disabled(bool disabled);
 bool MEM_CacheLimiter_is_disabled(void);
 #endif /* __MEM_CACHELIMITER_H__ */
 
+/**
+ * Account memory of caches which are not managed by a cache limiter,
+ * but share the same maximum. Cache limiters free their own elements
+ * until their memory together with external memory fits the maximum.
+ *
+ * \param size: Size of added or removed data in bytes.
+ */
+
+void MEM_CacheLimiter_add_external_memory(size_t size);
+void MEM_CacheLimiter_remove_external_memory(size_t size);
+
 /**
  * Create new MEM_CacheLimiter object
  * managed objects are destructed with the data_destructor
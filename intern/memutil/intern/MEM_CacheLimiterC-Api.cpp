@@ -18,12 +18,14 @@
  * \ingroup memutil
  */
 
+#include <atomic>
 #include <cstddef>
 
 #include "MEM_CacheLimiter.h"
 #include "MEM_CacheLimiterC-Api.h"
 
 static bool is_disabled = false;
+static std::atomic<size_t> external_memory(0);
 
 static size_t &get_max()
 {
@@ -41,6 +43,21 @@ size_t MEM_CacheLimiter_get_maximum()
   return get_max();
 }
 
+void MEM_CacheLimiter_add_external_memory(size_t size)
+{
+  external_memory += size;
+}
+
+void MEM_CacheLimiter_remove_external_memory(size_t size)
+{
+  external_memory -= size;
+}
+
+size_t MEM_CacheLimiter_get_external_memory()
+{
+  return external_memory;
+}
+
 void MEM_CacheLimiter_set_disabled(bool disabled)
 {
   is_disabled = disabled;
@@ -55,6 +55,7 @@ struct MTex;
 struct Main;
 struct Material;
 struct PointerRNA;
+struct Render;
 struct RenderData;
 struct Scene;
 struct SpaceNode;
@@ -1230,6 +1231,14 @@ void ntreeCompositExecTree(struct Scene *scene,
                            const struct ColorManagedViewSettings *view_settings,
                            const struct ColorManagedDisplaySettings *display_settings,
                            const char *view_name);
+/* Execute a localized tree for one frame of a batch render, writing into its own render. */
+void ntreeCompositExecFrame(struct Scene *scene,
+                            struct bNodeTree *ntree,
+                            struct RenderData *rd,
+                            struct Render *re,
+                            const struct ColorManagedViewSettings *view_settings,
+                            const struct ColorManagedDisplaySettings *display_settings,
+                            const char *view_name);
 void ntreeCompositTagRender(struct Scene *scene);
 void ntreeCompositUpdateRLayers(struct bNodeTree *ntree);
 void ntreeCompositRegisterPass(struct bNodeTree *ntree,
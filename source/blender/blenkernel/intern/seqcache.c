@@ -24,6 +24,9 @@
 #include <stddef.h>
 #include <time.h>
 
+#include "zlib.h"
+
+#include "MEM_CacheLimiterC-Api.h"
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
@@ -33,6 +36,7 @@
 #include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
+#include "IMB_moviecache.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_endian_switch.h"
@@ -42,6 +46,7 @@
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_global.h"
@@ -49,6 +54,14 @@
 #include "BKE_scene.h"
 #include "BKE_sequencer.h"
 
+#ifdef WITH_LZO
+#  ifdef WITH_SYSTEM_LZO
+#    include <lzo/lzo1x.h>
+#  else
+#    include "minilzo.h"
+#  endif
+#endif
+
 /**
  * Sequencer Cache Design Notes
  * ============================
@@ -73,6 +86,11 @@
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
  *
+ * Memory limit is shared with image and movie clip caches. Memory used by sequencer cache is
+ * accounted as external memory of cache limiter, so movie caches free their items when sequencer
+ * cache grows and vice versa. When sequencer cache has nothing to free, movie caches are asked
+ * to enforce their limits.
+ *
  *
  * Disk Cache Design Notes
  * =======================
@@ -81,7 +99,12 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * Zlib compression with user definable level can be used to compress image data(per image)
+ * Image data is split into blocks of DCACHE_BLOCK_SIZE bytes, which are compressed independently
+ * so they can be encoded and decoded in parallel. Stored image starts with table of compressed
+ * block sizes, followed by block data. Blocks, that can't be compressed are stored as is.
+ * Compression codec depends on user preferences: LZO is used for low compression, because it
+ * decompresses faster than storage can deliver data, zlib is used for high compression.
+ * Whole image is read from file at once and decompressed in memory.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -94,11 +117,19 @@
 /* <cache type>-<resolution X>x<resolution Y>-<rendersize>%(<view_id>)-<frame no>.dcf */
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
-#define DCACHE_CURRENT_VERSION 1
+#define DCACHE_CURRENT_VERSION 2
+#define DCACHE_BLOCK_SIZE (1024 * 1024)
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in imb intern */
 
+enum {
+  DCACHE_CODEC_NONE = 0,
+  DCACHE_CODEC_ZLIB = 1,
+  DCACHE_CODEC_LZO = 2,
+};
+
 typedef struct DiskCacheHeaderEntry {
   unsigned char encoding;
+  unsigned char codec;
   uint64_t frameno;
   uint64_t size_compressed;
   uint64_t size_raw;
@@ -186,6 +217,22 @@ static int seq_disk_cache_compression_level(void)
   return U.sequencer_disk_cache_compression;
 }
 
+static unsigned char seq_disk_cache_codec(void)
+{
+  switch (U.sequencer_disk_cache_compression) {
+    case USER_SEQ_DISK_CACHE_COMPRESSION_NONE:
+      return DCACHE_CODEC_NONE;
+    case USER_SEQ_DISK_CACHE_COMPRESSION_LOW:
+#ifdef WITH_LZO
+      return DCACHE_CODEC_LZO;
+#else
+      return DCACHE_CODEC_ZLIB;
+#endif
+  }
+
+  return DCACHE_CODEC_ZLIB;
+}
+
 static size_t seq_disk_cache_size_limit(void)
 {
   return (size_t)U.sequencer_disk_cache_size_limit * (1024 * 1024 * 1024);
@@ -474,29 +521,214 @@ static void seq_disk_cache_invalidate(Scene *scene,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
-static size_t deflate_imbuf_to_file(ImBuf *ibuf,
-                                    FILE *file,
-                                    int level,
-                                    DiskCacheHeaderEntry *header_entry)
+typedef struct DiskCacheBlockData {
+  unsigned char codec;
+  int level;
+  size_t size_raw;
+  unsigned char *raw;
+  /* Compressed blocks, NULL for blocks stored without compression. */
+  unsigned char **blocks;
+  uint64_t *block_sizes;
+  /* Block data of whole image read from file. */
+  const unsigned char *compressed;
+  const uint64_t *block_offsets;
+  bool *block_valid;
+} DiskCacheBlockData;
+
+static int seq_disk_cache_block_count(size_t size_raw)
 {
-  if (ibuf->rect) {
-    return BLI_gzip_mem_to_file_at_pos(
-        ibuf->rect, header_entry->size_raw, file, header_entry->offset, level);
+  return (int)((size_raw + DCACHE_BLOCK_SIZE - 1) / DCACHE_BLOCK_SIZE);
+}
+
+static size_t seq_disk_cache_block_size_raw(size_t size_raw, int block)
+{
+  const size_t offset = (size_t)block * DCACHE_BLOCK_SIZE;
+  return min_zz(DCACHE_BLOCK_SIZE, size_raw - offset);
+}
+
+static void seq_disk_cache_compress_block_task(void *__restrict userdata,
+                                               const int i,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DiskCacheBlockData *data = (DiskCacheBlockData *)userdata;
+  const size_t size_raw = seq_disk_cache_block_size_raw(data->size_raw, i);
+  const unsigned char *in = data->raw + (size_t)i * DCACHE_BLOCK_SIZE;
+  unsigned char *out = NULL;
+  size_t out_len = 0;
+
+  switch (data->codec) {
+    case DCACHE_CODEC_ZLIB: {
+      /* Output is only useful if it is smaller than input. */
+      uLongf dest_len = size_raw;
+      out = MEM_mallocN(size_raw, "disk cache block");
+      if (compress2(out, &dest_len, in, size_raw, data->level) == Z_OK) {
+        out_len = dest_len;
+      }
+      break;
+    }
+#ifdef WITH_LZO
+    case DCACHE_CODEC_LZO: {
+      lzo_uint dest_len = 0;
+      void *wrkmem = MEM_mallocN(LZO1X_MEM_COMPRESS, "disk cache lzo wrkmem");
+      out = MEM_mallocN(size_raw + size_raw / 16 + 64 + 3, "disk cache block");
+      if (lzo1x_1_compress(in, size_raw, out, &dest_len, wrkmem) == LZO_E_OK) {
+        out_len = dest_len;
+      }
+      MEM_freeN(wrkmem);
+      break;
+    }
+#endif
+  }
+
+  if (out_len == 0 || out_len >= size_raw) {
+    MEM_SAFE_FREE(out);
+    out_len = size_raw;
   }
 
-  return BLI_gzip_mem_to_file_at_pos(
-      ibuf->rect_float, header_entry->size_raw, file, header_entry->offset, level);
+  data->blocks[i] = out;
+  data->block_sizes[i] = out_len;
 }
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
+static void seq_disk_cache_decompress_block_task(void *__restrict userdata,
+                                                 const int i,
+                                                 const TaskParallelTLS *__restrict UNUSED(tls))
 {
-  if (ibuf->rect) {
-    return BLI_ungzip_file_to_mem_at_pos(
-        ibuf->rect, header_entry->size_raw, file, header_entry->offset);
+  DiskCacheBlockData *data = (DiskCacheBlockData *)userdata;
+  const size_t size_raw = seq_disk_cache_block_size_raw(data->size_raw, i);
+  const unsigned char *in = data->compressed + data->block_offsets[i];
+  unsigned char *out = data->raw + (size_t)i * DCACHE_BLOCK_SIZE;
+  bool valid = false;
+
+  if (data->block_sizes[i] == size_raw) {
+    memcpy(out, in, size_raw);
+    valid = true;
+  }
+  else if (data->codec == DCACHE_CODEC_ZLIB) {
+    uLongf dest_len = size_raw;
+    valid = uncompress(out, &dest_len, in, data->block_sizes[i]) == Z_OK && dest_len == size_raw;
   }
+#ifdef WITH_LZO
+  else if (data->codec == DCACHE_CODEC_LZO) {
+    lzo_uint dest_len = size_raw;
+    valid = lzo1x_decompress_safe(in, data->block_sizes[i], out, &dest_len, NULL) == LZO_E_OK &&
+            dest_len == size_raw;
+  }
+#endif
 
-  return BLI_ungzip_file_to_mem_at_pos(
-      ibuf->rect_float, header_entry->size_raw, file, header_entry->offset);
+  data->block_valid[i] = valid;
+}
+
+static size_t seq_disk_cache_compress_imbuf_to_file(ImBuf *ibuf,
+                                                    FILE *file,
+                                                    DiskCacheHeaderEntry *header_entry)
+{
+  const int block_count = seq_disk_cache_block_count(header_entry->size_raw);
+  DiskCacheBlockData data = {
+      .codec = header_entry->codec,
+      .level = seq_disk_cache_compression_level(),
+      .size_raw = header_entry->size_raw,
+      .raw = ibuf->rect ? (unsigned char *)ibuf->rect : (unsigned char *)ibuf->rect_float,
+  };
+  data.blocks = MEM_callocN(sizeof(*data.blocks) * block_count, "disk cache blocks");
+  data.block_sizes = MEM_callocN(sizeof(*data.block_sizes) * block_count,
+                                 "disk cache block sizes");
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (block_count > 1);
+  BLI_task_parallel_range(0, block_count, &data, seq_disk_cache_compress_block_task, &settings);
+
+  size_t bytes_written = 0;
+  fseek(file, header_entry->offset, 0);
+  if (fwrite(data.block_sizes, sizeof(*data.block_sizes), block_count, file) == (size_t)block_count) {
+    bytes_written = sizeof(*data.block_sizes) * block_count;
+
+    for (int i = 0; i < block_count; i++) {
+      const unsigned char *block = data.blocks[i] ? data.blocks[i] :
+                                                    data.raw + (size_t)i * DCACHE_BLOCK_SIZE;
+      if (fwrite(block, 1, data.block_sizes[i], file) != data.block_sizes[i]) {
+        bytes_written = 0;
+        break;
+      }
+      bytes_written += data.block_sizes[i];
+    }
+  }
+
+  for (int i = 0; i < block_count; i++) {
+    MEM_SAFE_FREE(data.blocks[i]);
+  }
+  MEM_freeN(data.blocks);
+  MEM_freeN(data.block_sizes);
+
+  return bytes_written;
+}
+
+static size_t seq_disk_cache_decompress_file_to_imbuf(ImBuf *ibuf,
+                                                      FILE *file,
+                                                      DiskCacheHeaderEntry *header_entry)
+{
+  const int block_count = seq_disk_cache_block_count(header_entry->size_raw);
+  const size_t table_size = sizeof(uint64_t) * block_count;
+
+  if (header_entry->size_compressed < table_size) {
+    return 0;
+  }
+
+  /* Read all blocks at once, so storage bandwidth is not limited by decompression. */
+  unsigned char *compressed = MEM_mallocN(header_entry->size_compressed, "disk cache data");
+  fseek(file, header_entry->offset, 0);
+  if (fread(compressed, header_entry->size_compressed, 1, file) != 1) {
+    MEM_freeN(compressed);
+    return 0;
+  }
+
+  uint64_t *block_sizes = (uint64_t *)compressed;
+  uint64_t *block_offsets = MEM_mallocN(sizeof(*block_offsets) * block_count,
+                                        "disk cache block offsets");
+  uint64_t offset = table_size;
+
+  for (int i = 0; i < block_count; i++) {
+    if ((ENDIAN_ORDER == B_ENDIAN) && header_entry->encoding == 0) {
+      BLI_endian_switch_uint64(&block_sizes[i]);
+    }
+    block_offsets[i] = offset;
+    offset += block_sizes[i];
+  }
+
+  size_t bytes_read = 0;
+
+  if (offset == header_entry->size_compressed) {
+    DiskCacheBlockData data = {
+        .codec = header_entry->codec,
+        .size_raw = header_entry->size_raw,
+        .raw = ibuf->rect ? (unsigned char *)ibuf->rect : (unsigned char *)ibuf->rect_float,
+        .block_sizes = block_sizes,
+        .compressed = compressed,
+        .block_offsets = block_offsets,
+    };
+    data.block_valid = MEM_callocN(sizeof(*data.block_valid) * block_count,
+                                   "disk cache block valid");
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (block_count > 1);
+    BLI_task_parallel_range(
+        0, block_count, &data, seq_disk_cache_decompress_block_task, &settings);
+
+    bytes_read = header_entry->size_raw;
+    for (int i = 0; i < block_count; i++) {
+      if (!data.block_valid[i]) {
+        bytes_read = 0;
+        break;
+      }
+    }
+    MEM_freeN(data.block_valid);
+  }
+
+  MEM_freeN(block_offsets);
+  MEM_freeN(compressed);
+
+  return bytes_read;
 }
 
 static void seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
@@ -552,6 +784,7 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
     header->entry[i].encoding = 0;
   }
 
+  header->entry[i].codec = seq_disk_cache_codec();
   header->entry[i].offset = offset;
   header->entry[i].frameno = key->nfra;
 
@@ -602,8 +835,8 @@ static bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key
   memset(&header, 0, sizeof(header));
   seq_disk_cache_read_header(file, &header);
   int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
-  size_t bytes_written = deflate_imbuf_to_file(
-      ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
+  size_t bytes_written = seq_disk_cache_compress_imbuf_to_file(
+      ibuf, file, &header.entry[entry_index]);
 
   if (bytes_written != 0) {
     /* Last step is writing header, as image data can be overwritten,
@@ -662,7 +895,8 @@ static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *ke
     return NULL;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  size_t bytes_read = seq_disk_cache_decompress_file_to_imbuf(
+      ibuf, file, &header.entry[entry_index]);
 
   /* Sanity check. */
   if (bytes_read != expected_size) {
@@ -681,6 +915,7 @@ static ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *ke
 #undef DCACHE_IMAGES_PER_FILE
 #undef COLORSPACE_NAME_MAX
 #undef DCACHE_CURRENT_VERSION
+#undef DCACHE_BLOCK_SIZE
 
 static bool seq_cmp_render_data(const SeqRenderData *a, const SeqRenderData *b)
 {
@@ -768,6 +1003,12 @@ static size_t seq_cache_get_mem_total(void)
   return ((size_t)U.memcachelimit) * 1024 * 1024;
 }
 
+/* Memory used by sequencer caches of all scenes and by image and movie clip caches. */
+static size_t seq_cache_get_mem_in_use(void)
+{
+  return MEM_CacheLimiter_get_external_memory() + IMB_moviecache_get_memory_in_use();
+}
+
 static void seq_cache_keyfree(void *val)
 {
   SeqCacheKey *key = val;
@@ -780,7 +1021,9 @@ static void seq_cache_valfree(void *val)
   SeqCache *cache = item->cache_owner;
 
   if (item->ibuf) {
-    cache->memory_used -= IMB_get_size_in_memory(item->ibuf);
+    const size_t size = IMB_get_size_in_memory(item->ibuf);
+    cache->memory_used -= size;
+    MEM_CacheLimiter_remove_external_memory(size);
     IMB_freeImBuf(item->ibuf);
   }
 
@@ -796,8 +1039,10 @@ static void seq_cache_put(SeqCache *cache, SeqCacheKey *key, ImBuf *ibuf)
 
   if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree)) {
     IMB_refImBuf(ibuf);
+    const size_t size = IMB_get_size_in_memory(ibuf);
     cache->last_key = key;
-    cache->memory_used += IMB_get_size_in_memory(ibuf);
+    cache->memory_used += size;
+    MEM_CacheLimiter_add_external_memory(size);
   }
 }
 
@@ -991,15 +1236,17 @@ bool BKE_sequencer_cache_recycle_item(Scene *scene)
 
   seq_cache_lock(scene);
 
-  while (cache->memory_used > memory_total) {
+  while (seq_cache_get_mem_in_use() > memory_total) {
     SeqCacheKey *finalkey = seq_cache_get_item_for_removal(scene);
 
     if (finalkey) {
       seq_cache_recycle_linked(scene, finalkey);
     }
     else {
+      /* Nothing left to free in this scene, let movie caches give up their memory. */
+      IMB_moviecache_enforce_limits();
       seq_cache_unlock(scene);
-      return false;
+      return seq_cache_get_mem_in_use() <= memory_total;
     }
   }
   seq_cache_unlock(scene);
@@ -1451,5 +1698,5 @@ bool BKE_sequencer_cache_is_full(Scene *scene)
     return false;
   }
 
-  return memory_total < cache->memory_used;
+  return memory_total < seq_cache_get_mem_in_use();
 }
@@ -50,6 +50,7 @@
 #include "BLI_session_uuid.h"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -3992,6 +3993,101 @@ static ImBuf *seq_render_strip_stack_apply_effect(
   return out;
 }
 
+/* Strips which only read their own data when rendering, so they can be rendered at the same
+ * time as the other strips of the stack. Effects render their inputs and mask modifiers render
+ * other strips, scene strips use the render pipeline or the viewport. */
+static bool seq_render_strip_is_independent(Sequence *seq)
+{
+  if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE, SEQ_TYPE_COLOR)) {
+    return false;
+  }
+
+  LISTBASE_FOREACH (SequenceModifierData *, smd, &seq->modifiers) {
+    if (smd->mask_sequence) {
+      return false;
+    }
+  }
+  return true;
+}
+
+typedef struct SeqRenderStackData {
+  const SeqRenderData *context;
+  SeqRenderState *state;
+  Sequence **seq_arr;
+  ImBuf **ibuf_arr;
+  const int *index_arr;
+  float cfra;
+} SeqRenderStackData;
+
+static void seq_render_strip_stack_task(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SeqRenderStackData *data = userdata;
+  const int index = data->index_arr[i];
+
+  data->ibuf_arr[index] = seq_render_strip(
+      data->context, data->state, data->seq_arr[index], data->cfra);
+}
+
+/* Render the independent strips of the stack which are used from the base up, in parallel. */
+static void seq_render_strip_stack_inputs(const SeqRenderData *context,
+                                          SeqRenderState *state,
+                                          Sequence **seq_arr,
+                                          ImBuf **ibuf_arr,
+                                          int count,
+                                          int base,
+                                          bool render_base,
+                                          float cfra)
+{
+  int index_arr[MAXSEQ + 1];
+  int tot = 0;
+
+  if (render_base && seq_render_strip_is_independent(seq_arr[base])) {
+    index_arr[tot++] = base;
+  }
+  for (int i = base + 1; i < count; i++) {
+    if (seq_get_early_out_for_blend_mode(seq_arr[i]) == EARLY_DO_EFFECT &&
+        seq_render_strip_is_independent(seq_arr[i])) {
+      index_arr[tot++] = i;
+    }
+  }
+
+  if (tot < 2) {
+    return;
+  }
+
+  SeqRenderStackData data = {
+      .context = context,
+      .state = state,
+      .seq_arr = seq_arr,
+      .ibuf_arr = ibuf_arr,
+      .index_arr = index_arr,
+      .cfra = cfra,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, tot, &data, seq_render_strip_stack_task, &settings);
+}
+
+/* Take the strip image rendered in advance, or render it now. */
+static ImBuf *seq_render_strip_stack_input(const SeqRenderData *context,
+                                           SeqRenderState *state,
+                                           Sequence **seq_arr,
+                                           ImBuf **ibuf_arr,
+                                           int i,
+                                           float cfra)
+{
+  ImBuf *ibuf = ibuf_arr[i];
+  if (ibuf == NULL) {
+    return seq_render_strip(context, state, seq_arr[i], cfra);
+  }
+  ibuf_arr[i] = NULL;
+  return ibuf;
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      SeqRenderState *state,
                                      ListBase *seqbasep,
@@ -3999,8 +4095,10 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
                                      int chanshown)
 {
   Sequence *seq_arr[MAXSEQ + 1];
+  ImBuf *ibuf_arr[MAXSEQ + 1] = {NULL};
   int count;
   int i;
+  int early_out = EARLY_NO_INPUT;
   ImBuf *out = NULL;
   clock_t begin;
 
@@ -4010,8 +4108,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
     return NULL;
   }
 
+  /* Find the strip the stack is built on, from the top. */
   for (i = count - 1; i >= 0; i--) {
-    int early_out;
     Sequence *seq = seq_arr[i];
 
     out = BKE_sequencer_cache_get(context, seq, cfra, SEQ_CACHE_STORE_COMPOSITE, false);
@@ -4020,42 +4118,45 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
       break;
     }
     if (seq->blend_mode == SEQ_BLEND_REPLACE) {
-      out = seq_render_strip(context, state, seq, cfra);
+      early_out = EARLY_NO_INPUT;
       break;
     }
 
     early_out = seq_get_early_out_for_blend_mode(seq);
 
+    if (ELEM(early_out, EARLY_NO_INPUT, EARLY_USE_INPUT_2) || i == 0) {
+      break;
+    }
+  }
+
+  seq_render_strip_stack_inputs(
+      context, state, seq_arr, ibuf_arr, count, i, !out && early_out != EARLY_USE_INPUT_1, cfra);
+
+  if (out == NULL) {
     switch (early_out) {
       case EARLY_NO_INPUT:
       case EARLY_USE_INPUT_2:
-        out = seq_render_strip(context, state, seq, cfra);
+        out = seq_render_strip_stack_input(context, state, seq_arr, ibuf_arr, i, cfra);
         break;
       case EARLY_USE_INPUT_1:
-        if (i == 0) {
-          out = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
-        }
+        out = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
         break;
-      case EARLY_DO_EFFECT:
-        if (i == 0) {
-          begin = seq_estimate_render_cost_begin();
+      case EARLY_DO_EFFECT: {
+        begin = seq_estimate_render_cost_begin();
 
-          ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
-          ImBuf *ibuf2 = seq_render_strip(context, state, seq, cfra);
+        ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
+        ImBuf *ibuf2 = seq_render_strip_stack_input(context, state, seq_arr, ibuf_arr, i, cfra);
 
-          out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
+        out = seq_render_strip_stack_apply_effect(context, seq_arr[i], cfra, ibuf1, ibuf2);
 
-          float cost = seq_estimate_render_cost_end(context->scene, begin);
-          BKE_sequencer_cache_put(
-              context, seq_arr[i], cfra, SEQ_CACHE_STORE_COMPOSITE, out, cost, false);
+        float cost = seq_estimate_render_cost_end(context->scene, begin);
+        BKE_sequencer_cache_put(
+            context, seq_arr[i], cfra, SEQ_CACHE_STORE_COMPOSITE, out, cost, false);
 
-          IMB_freeImBuf(ibuf1);
-          IMB_freeImBuf(ibuf2);
-        }
+        IMB_freeImBuf(ibuf1);
+        IMB_freeImBuf(ibuf2);
         break;
-    }
-    if (out) {
-      break;
+      }
     }
   }
 
@@ -4066,7 +4167,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context,
 
     if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
       ImBuf *ibuf1 = out;
-      ImBuf *ibuf2 = seq_render_strip(context, state, seq, cfra);
+      ImBuf *ibuf2 = seq_render_strip_stack_input(context, state, seq_arr, ibuf_arr, i, cfra);
 
       out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
 
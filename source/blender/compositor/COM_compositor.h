@@ -21,6 +21,8 @@
 #include "DNA_color_types.h"
 #include "DNA_node_types.h"
 
+struct Render;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -157,8 +159,11 @@ extern "C" {
  * The relevant ExecutionGroup (that can calculate the missing chunks; ExecutionGroup A)
  * is asked to calculate the area ExecutionGroup B is missing.
  * [@ref ExecutionGroup.scheduleAreaWhenPossible]
- * ExecutionGroup B checks what chunks the area spans, and tries to schedule these chunks.
- * If all input data is available these chunks are scheduled [@ref ExecutionGroup.scheduleChunk]
+ * ExecutionGroup A checks what chunks the area spans, and schedules these chunks with the chunk
+ * of ExecutionGroup B as their dependent. Chunks of which all input data is available are added
+ * to the WorkScheduler [@ref ExecutionGroup.scheduleChunks], when a chunk finishes its
+ * dependents that are not waiting for other chunks anymore are added as well
+ * [@ref ExecutionGroup.finalizeChunkExecution]
  *
  * <pre>
  *
@@ -182,7 +187,7 @@ extern "C" {
  *            .                                .  .                                         .  O-------/
  *            .                                .  .                                         .  O
  *            .                                .  .                                         .  O
- *            .                                .  .                                         .  O-------\ ExecutionGroup.scheduleChunk
+ *            .                                .  .                                         .  O-------\ ExecutionGroup.scheduleChunks
  *            .                                .  .                                         .  .       |
  *            .                                .  .                                         .  .  O----/
  *            .                                .  .                                         .  O<=O
@@ -221,12 +226,12 @@ extern "C" {
  *
  * \see ExecutionGroup.execute Execute a complete ExecutionGroup.
  * Halts until finished or breaked by user
- * \see ExecutionGroup.scheduleChunkWhenPossible Tries to schedule a single chunk,
- * checks if all input data is available. Can trigger dependent chunks to be calculated
+ * \see ExecutionGroup.scheduleChunkWhenPossible Schedules a single chunk,
+ * after the chunks it depends on. Can trigger dependent chunks to be calculated
  * \see ExecutionGroup.scheduleAreaWhenPossible
- * Tries to schedule an area. This can be multiple chunks
+ * Schedules an area. This can be multiple chunks
  * (is called from [@ref ExecutionGroup.scheduleChunkWhenPossible])
- * \see ExecutionGroup.scheduleChunk Schedule a chunk on the WorkScheduler
+ * \see ExecutionGroup.scheduleChunks Add chunks to the WorkScheduler
  * \see NodeOperation.determineDependingAreaOfInterest Influence the area of interest of a chunk.
  * \see WriteBufferOperation Operation to write to a MemoryProxy/MemoryBuffer
  * \see ReadBufferOperation Operation to read from a MemoryProxy/MemoryBuffer
@@ -241,12 +246,9 @@ extern "C" {
  * For witching these between the state you need to recompile blender
  *
  * \subsection multithread Multi threaded
- * Default the work-scheduler will place all work as WorkPackage in a queue.
- * For every CPUcore a working thread is created.
- * These working threads will ask the WorkScheduler if there is work
- * for a specific Device.
- * the work-scheduler will find work for the device and the device
- * will be asked to execute the WorkPackage.
+ * Default the work-scheduler will push all CPU work as WorkPackage into a BLI_task pool.
+ * The threads of the task scheduler, shared with the rest of Blender, execute these packages.
+ * OpenCL devices get a working thread of their own that takes work from a queue.
  *
  * \subsection singlethread Single threaded
  * For debugging reasons the multi-threading can be disabled.
@@ -347,6 +349,27 @@ void COM_execute(RenderData *rd,
                  const ColorManagedDisplaySettings *displaySettings,
                  const char *viewName);
 
+/**
+ * \brief Execute the compositor tree for a single frame of a batch render.
+ *
+ * Unlike COM_execute this does not lock the compositor, so multiple frames can be
+ * executed at the same time, each writing its result into its own render.
+ * No previews are created and OpenCL is not used.
+ *
+ * \param editingtree: [struct bNodeTree]
+ *   a localized node tree, the OpenCL flag is cleared on it.
+ *
+ * \param re: [struct Render]
+ *   the render that receives the result of the composite node.
+ */
+void COM_execute_frame(RenderData *rd,
+                       Scene *scene,
+                       bNodeTree *editingtree,
+                       struct Render *re,
+                       const ColorManagedViewSettings *viewSettings,
+                       const ColorManagedDisplaySettings *displaySettings,
+                       const char *viewName);
+
 /**
  * \brief Deinitialize the compositor caches and allocated memory.
  * Use COM_clearCaches to only free the caches.
@@ -357,7 +380,7 @@ void COM_deinitialize(void);
  * \brief Clear all compositor caches. (Compositor system will still remain available).
  * To deinitialize the compositor use the COM_deinitialize method.
  */
-// void COM_clearCaches(void); // NOT YET WRITTEN
+void COM_clearCaches(void);
 
 #ifdef __cplusplus
 }
@@ -67,10 +67,11 @@ typedef enum CompositorPriority {
 
 // workscheduler threading models
 /**
- * COM_TM_QUEUE is a multi-threaded model, which uses the BLI_thread_queue pattern.
+ * COM_TM_TASK is a multi-threaded model, which executes chunks as tasks of a BLI_task pool as
+ * soon as the chunks they depend on are executed. OpenCL devices use a thread of their own.
  * This is the default option.
  */
-#define COM_TM_QUEUE 1
+#define COM_TM_TASK 1
 
 /**
  * COM_TM_NOTHREAD is a single threading model, everything is executed in the caller thread.
@@ -79,9 +80,9 @@ typedef enum CompositorPriority {
 #define COM_TM_NOTHREAD 0
 
 /**
- * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_QUEUE is currently default.
+ * COM_CURRENT_THREADING_MODEL can be one of the above, COM_TM_TASK is currently default.
  */
-#define COM_CURRENT_THREADING_MODEL COM_TM_QUEUE
+#define COM_CURRENT_THREADING_MODEL COM_TM_TASK
 // chunk order
 /**
  * \brief The order of chunks to be scheduled
@@ -106,4 +107,10 @@ typedef enum OrderOfChunks {
 #define COM_NUM_CHANNELS_VECTOR 3
 #define COM_NUM_CHANNELS_COLOR 4
 
+/**
+ * Maximum number of pixels calculated at once by SocketReader::executeSpanSampled.
+ * Small enough for operations to keep the spans of their inputs on the stack.
+ */
+#define COM_SPAN_MAX_WIDTH 64
+
 #define COM_BLUR_BOKEH_PIXELS 512
@@ -0,0 +1,337 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include "COM_BufferCache.h"
+
+#include <list>
+#include <string.h>
+#include <typeinfo>
+
+#include "BLI_listbase.h"
+#include "BLI_threads.h"
+
+#include "BKE_node.h"
+
+#include "DNA_color_types.h"
+#include "DNA_node_types.h"
+
+#include "COM_CompositorContext.h"
+#include "COM_MemoryBuffer.h"
+#include "COM_MemoryProxy.h"
+#include "COM_NodeOperation.h"
+#include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
+
+#include "MEM_CacheLimiterC-Api.h"
+#include "MEM_guardedalloc.h"
+
+/* ******** Cache Hash ******** */
+
+CacheHash::CacheHash()
+{
+  BLI_hash_mm2a_init(&this->m_low, 0);
+  BLI_hash_mm2a_init(&this->m_high, 0x9e3779b9);
+}
+
+void CacheHash::add(const void *data, size_t len)
+{
+  BLI_hash_mm2a_add(&this->m_low, (const unsigned char *)data, len);
+  BLI_hash_mm2a_add(&this->m_high, (const unsigned char *)data, len);
+}
+
+void CacheHash::addInt(int value)
+{
+  BLI_hash_mm2a_add_int(&this->m_low, value);
+  BLI_hash_mm2a_add_int(&this->m_high, value);
+}
+
+void CacheHash::addFloat(float value)
+{
+  add(&value, sizeof(value));
+}
+
+void CacheHash::addString(const char *str)
+{
+  if (str) {
+    add(str, strlen(str));
+  }
+  /* Terminate, so consecutive strings don't hash the same when split differently. */
+  addInt(0);
+}
+
+void CacheHash::addHash(uint64_t hash)
+{
+  add(&hash, sizeof(hash));
+}
+
+uint64_t CacheHash::end()
+{
+  return ((uint64_t)BLI_hash_mm2a_end(&this->m_high) << 32) |
+         (uint64_t)BLI_hash_mm2a_end(&this->m_low);
+}
+
+/* Hash curve mapping settings by value, the curve and table arrays are reallocated whenever
+ * the node tree is localized. */
+static void hash_curve_mapping(CacheHash &hash, const CurveMapping *cumap)
+{
+  hash.addInt(cumap->flag);
+  hash.addInt(cumap->tone);
+  hash.add(&cumap->clipr, sizeof(cumap->clipr));
+  hash.add(cumap->black, sizeof(cumap->black));
+  hash.add(cumap->white, sizeof(cumap->white));
+  for (int i = 0; i < CM_TOT; i++) {
+    const CurveMap *cuma = &cumap->cm[i];
+    if (cuma->curve) {
+      hash.add(cuma->curve, sizeof(CurveMapPoint) * cuma->totpoint);
+    }
+  }
+}
+
+/* ******** Buffer Cache Keys ******** */
+
+BufferCacheKeys::BufferCacheKeys(const CompositorContext &context)
+{
+  CacheHash hash;
+  const RenderData *rd = context.getRenderData();
+  hash.addInt(context.getFramenumber());
+  hash.addInt(rd->xsch);
+  hash.addInt(rd->ysch);
+  hash.addInt(rd->size);
+  hash.addInt(context.getQuality());
+  hash.addInt(context.isRendering());
+  hash.addInt(context.isFastCalculation());
+  hash.addInt(context.isHalfBufferEnabled());
+  hash.addString(context.getViewName());
+
+  const ColorManagedViewSettings *view_settings = context.getViewSettings();
+  if (view_settings) {
+    hash.addString(view_settings->look);
+    hash.addString(view_settings->view_transform);
+    hash.addFloat(view_settings->exposure);
+    hash.addFloat(view_settings->gamma);
+    hash.addInt(view_settings->flag);
+    if (view_settings->curve_mapping) {
+      hash_curve_mapping(hash, view_settings->curve_mapping);
+    }
+  }
+  const ColorManagedDisplaySettings *display_settings = context.getDisplaySettings();
+  if (display_settings) {
+    hash.addString(display_settings->display_device);
+  }
+  this->m_seed = hash.end();
+}
+
+bool BufferCacheKeys::get(NodeOperation *operation, uint64_t *r_key)
+{
+  Keys::const_iterator it = this->m_keys.find(operation);
+  if (it != this->m_keys.end()) {
+    *r_key = it->second;
+    return true;
+  }
+  if (this->m_uncacheable.find(operation) != this->m_uncacheable.end()) {
+    return false;
+  }
+
+  CacheHash hash;
+  hash.addHash(this->m_seed);
+  hash.addString(typeid(*operation).name());
+  hash.addHash(operation->getSettingsHash());
+  hash.addInt(operation->getWidth());
+  hash.addInt(operation->getHeight());
+
+  bool cacheable = true;
+  if (operation->readsExternalData()) {
+    cacheable = operation->hashExternalData(&hash);
+  }
+  else if (operation->isSetOperation()) {
+    /* Constants are not always created for a node, hash their value instead. */
+    float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    operation->readSampled(value, 0.0f, 0.0f, COM_PS_NEAREST);
+    hash.add(value, sizeof(value));
+  }
+
+  if (cacheable && operation->isReadBufferOperation()) {
+    ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
+    uint64_t key;
+    cacheable = get(readOperation->getMemoryProxy()->getWriteBufferOperation(), &key);
+    hash.addHash(key);
+  }
+
+  for (unsigned int index = 0; cacheable && index < operation->getNumberOfInputSockets();
+       index++) {
+    NodeOperationInput *input = operation->getInputSocket(index);
+    uint64_t key = 0;
+    if (input->isConnected()) {
+      cacheable = get(&input->getLink()->getOperation(), &key);
+    }
+    hash.addHash(key);
+  }
+
+  if (!cacheable) {
+    this->m_uncacheable[operation] = 0;
+    return false;
+  }
+  *r_key = hash.end();
+  this->m_keys[operation] = *r_key;
+  return true;
+}
+
+/* ******** Buffer Cache ******** */
+
+typedef struct CacheEntry {
+  uint64_t key;
+  MemoryBuffer *buffer;
+  size_t mem_size;
+} CacheEntry;
+
+typedef std::list<CacheEntry> CacheEntries;
+
+/* Most recently used entries are at the front. */
+static CacheEntries s_entries;
+static size_t s_mem_size = 0;
+/* Executions of different frames can run at the same time in batch compositing. */
+static ThreadMutex s_mutex = BLI_MUTEX_INITIALIZER;
+
+static CacheEntries::iterator find_entry(uint64_t key)
+{
+  for (CacheEntries::iterator it = s_entries.begin(); it != s_entries.end(); ++it) {
+    if (it->key == key) {
+      return it;
+    }
+  }
+  return s_entries.end();
+}
+
+static void free_entry(CacheEntries::iterator it)
+{
+  s_mem_size -= it->mem_size;
+  MEM_CacheLimiter_remove_external_memory(it->mem_size);
+  delete it->buffer;
+  s_entries.erase(it);
+}
+
+uint64_t BufferCache::hashNode(const bNode *node)
+{
+  CacheHash hash;
+  hash.addInt(node->type);
+  hash.addInt(node->custom1);
+  hash.addInt(node->custom2);
+  hash.addFloat(node->custom3);
+  hash.addFloat(node->custom4);
+  hash.add(&node->id, sizeof(node->id));
+
+  /* Storage with pointers is hashed by value, as the tree is localized for every execution. */
+  if (node->storage) {
+    if (STREQ(node->typeinfo->storagename, "CurveMapping")) {
+      hash_curve_mapping(hash, (const CurveMapping *)node->storage);
+    }
+    else if (node->type == CMP_NODE_CRYPTOMATTE) {
+      const NodeCryptomatte *cryptomatte = (const NodeCryptomatte *)node->storage;
+      hash.add(cryptomatte->add, sizeof(cryptomatte->add));
+      hash.add(cryptomatte->remove, sizeof(cryptomatte->remove));
+      hash.addInt(cryptomatte->num_inputs);
+      hash.addString(cryptomatte->matte_id);
+    }
+    else if (node->typeinfo->storagename[0] != '\0') {
+      hash.add(node->storage, MEM_allocN_len(node->storage));
+    }
+    /* Storage without a DNA struct is runtime data, such as the movie distortion cache. */
+  }
+
+  /* Unlinked inputs are read from the socket values, value and color nodes store their
+   * result in the output sockets. */
+  const ListBase *socket_lists[2] = {&node->inputs, &node->outputs};
+  for (int i = 0; i < 2; i++) {
+    LISTBASE_FOREACH (const bNodeSocket *, sock, socket_lists[i]) {
+      if (sock->default_value) {
+        hash.add(sock->default_value, MEM_allocN_len(sock->default_value));
+      }
+    }
+  }
+
+  return hash.end();
+}
+
+bool BufferCache::restore(uint64_t key, MemoryProxy *proxy)
+{
+  MemoryBuffer *buffer = proxy->getBuffer();
+  BLI_mutex_lock(&s_mutex);
+  CacheEntries::iterator it = find_entry(key);
+  if (it == s_entries.end()) {
+    BLI_mutex_unlock(&s_mutex);
+    return false;
+  }
+  MemoryBuffer *cached = it->buffer;
+  if (cached->get_num_channels() != buffer->get_num_channels() ||
+      !BLI_rcti_compare(cached->getRect(), buffer->getRect())) {
+    BLI_mutex_unlock(&s_mutex);
+    return false;
+  }
+
+  buffer->copyContentFrom(cached);
+  buffer->setCreatedState();
+
+  s_entries.splice(s_entries.begin(), s_entries, it);
+  BLI_mutex_unlock(&s_mutex);
+  return true;
+}
+
+void BufferCache::store(uint64_t key, MemoryProxy *proxy)
+{
+  MemoryBuffer *buffer = proxy->getBuffer();
+  const size_t mem_size = buffer->getMemorySize();
+  /* A maximum of zero means the memory cache is not limited. */
+  const size_t max_mem_size = MEM_CacheLimiter_get_maximum();
+  if (mem_size == 0 || (max_mem_size != 0 && mem_size > max_mem_size)) {
+    return;
+  }
+
+  BLI_mutex_lock(&s_mutex);
+  CacheEntries::iterator it = find_entry(key);
+  if (it != s_entries.end()) {
+    s_entries.splice(s_entries.begin(), s_entries, it);
+    BLI_mutex_unlock(&s_mutex);
+    return;
+  }
+
+  while (!s_entries.empty() && max_mem_size != 0 && s_mem_size + mem_size > max_mem_size) {
+    free_entry(--s_entries.end());
+  }
+
+  CacheEntry entry;
+  entry.key = key;
+  entry.buffer = new MemoryBuffer(
+      proxy->getDataType(), buffer->getRect(), buffer->isHalfFloat());
+  entry.buffer->copyContentFrom(buffer);
+  entry.mem_size = mem_size;
+  s_entries.push_front(entry);
+  s_mem_size += mem_size;
+  /* Let the image and movie caches make room for the buffer. */
+  MEM_CacheLimiter_add_external_memory(mem_size);
+  BLI_mutex_unlock(&s_mutex);
+}
+
+void BufferCache::clear()
+{
+  BLI_mutex_lock(&s_mutex);
+  while (!s_entries.empty()) {
+    free_entry(s_entries.begin());
+  }
+  BLI_assert(s_mem_size == 0);
+  BLI_mutex_unlock(&s_mutex);
+}
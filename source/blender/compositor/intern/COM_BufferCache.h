@@ -0,0 +1,120 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#pragma once
+
+#include <map>
+
+#include "BLI_hash_mm2a.h"
+#include "BLI_sys_types.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#  include "MEM_guardedalloc.h"
+#endif
+
+class CompositorContext;
+class MemoryProxy;
+class NodeOperation;
+struct bNode;
+
+/**
+ * \brief Streaming hash of 64 bits used for the keys of the BufferCache.
+ * Two Murmur2A hashes with different seeds are combined, so that collisions
+ * between keys of buffers that are kept around are very unlikely.
+ * \ingroup Memory
+ */
+class CacheHash {
+ private:
+  BLI_HashMurmur2A m_low;
+  BLI_HashMurmur2A m_high;
+
+ public:
+  CacheHash();
+
+  void add(const void *data, size_t len);
+  void addInt(int value);
+  void addFloat(float value);
+  void addString(const char *str);
+  void addHash(uint64_t hash);
+
+  uint64_t end();
+};
+
+/**
+ * \brief Determines the cache keys of the buffers written by operations.
+ *
+ * The key of an operation combines its type, the settings of the node it was created for,
+ * its resolution, the external data it reads and the keys of all its inputs. Operations that
+ * read external data they can't hash make every operation depending on them uncacheable.
+ * \ingroup Memory
+ */
+class BufferCacheKeys {
+ private:
+  typedef std::map<NodeOperation *, uint64_t> Keys;
+
+  uint64_t m_seed;
+  Keys m_keys;
+  Keys m_uncacheable;
+
+ public:
+  BufferCacheKeys(const CompositorContext &context);
+
+  /**
+   * Get the key of the output of an operation, returns false when it can't be cached.
+   * \note only call this after the operations are initialized, external data is hashed
+   * when it is available for execution.
+   */
+  bool get(NodeOperation *operation, uint64_t *r_key);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+  MEM_CXX_CLASS_ALLOC_FUNCS("COM:BufferCacheKeys")
+#endif
+};
+
+/**
+ * \brief Buffers of earlier executions of the node tree, so unchanged parts of the tree
+ * don't have to be calculated again when a setting further down the tree changes.
+ *
+ * The cache shares the memory cache limit of the user preferences with the image, movie and
+ * sequencer caches, the least recently used buffers are freed once it is exceeded. Buffers are
+ * only kept for interactive executions, not for renders.
+ * \ingroup Memory
+ */
+class BufferCache {
+ public:
+  /**
+   * Hash all settings of a node that affect the operations created for it.
+   */
+  static uint64_t hashNode(const bNode *node);
+
+  /**
+   * Copy the cached buffer with the given key into the buffer of a memory proxy,
+   * returns false when there is none.
+   */
+  static bool restore(uint64_t key, MemoryProxy *proxy);
+
+  /**
+   * Add a copy of the buffer of a memory proxy to the cache.
+   */
+  static void store(uint64_t key, MemoryProxy *proxy);
+
+  /**
+   * Free all cached buffers.
+   */
+  static void clear();
+};
@@ -22,8 +22,8 @@
 
 /**
  * \brief class representing a CPU device.
- * \note for every hardware thread in the system a CPUDevice instance
- * will exist in the workscheduler.
+ * \note the workscheduler creates a CPUDevice for every task executing WorkPackages on the CPU,
+ * with a thread id that is unique among the running tasks.
  */
 class CPUDevice : public Device {
  public:
@@ -26,6 +26,8 @@
 #include <string>
 #include <vector>
 
+struct Render;
+
 /**
  * \brief Overall context of the compositor
  */
@@ -61,6 +63,12 @@ class CompositorContext {
    */
   bNodeTree *m_bnodetree;
 
+  /**
+   * \brief Render that receives the result of the composite node.
+   * When NULL the render of the scene is used.
+   */
+  struct Render *m_render;
+
   /**
    * \brief Preview image hash table
    * This field is initialized in ExecutionSystem and must only be read from that point on.
@@ -149,6 +157,15 @@ class CompositorContext {
     return m_scene;
   }
 
+  void setRender(struct Render *render)
+  {
+    this->m_render = render;
+  }
+  struct Render *getRender() const
+  {
+    return this->m_render;
+  }
+
   /**
    * \brief set the preview image hash table
    */
@@ -267,4 +284,8 @@ class CompositorContext {
   {
     return (this->getbNodeTree()->flag & NTREE_COM_GROUPNODE_BUFFER) != 0;
   }
+  bool isHalfBufferEnabled() const
+  {
+    return (this->getbNodeTree()->flag & NTREE_COM_HALF_BUFFERS) != 0;
+  }
 };
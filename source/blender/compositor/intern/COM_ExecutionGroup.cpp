@@ -29,23 +29,34 @@
 #include "COM_ExecutionSystem.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_ViewerOperation.h"
+#include "COM_WorkPackage.h"
 #include "COM_WorkScheduler.h"
 #include "COM_WriteBufferOperation.h"
 #include "COM_defines.h"
 
 #include "BLI_math.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 #include "BLT_translation.h"
 #include "MEM_guardedalloc.h"
 #include "PIL_time.h"
 #include "WM_api.h"
 #include "WM_types.h"
 
+/**
+ * Protects the chunk execution states and dependencies of all execution groups, chunks are
+ * scheduled from the main thread while others finish executing.
+ */
+static ThreadMutex g_scheduleMutex = BLI_MUTEX_INITIALIZER;
+
 ExecutionGroup::ExecutionGroup()
 {
   this->m_isOutput = false;
   this->m_complex = false;
   this->m_chunkExecutionStates = NULL;
+  this->m_chunkPendingDependencies = NULL;
+  this->m_chunkDependents = NULL;
+  this->m_taskPool = NULL;
   this->m_bTree = NULL;
   this->m_height = 0;
   this->m_width = 0;
@@ -124,6 +135,14 @@ void ExecutionGroup::initExecution()
   if (this->m_chunkExecutionStates != NULL) {
     MEM_freeN(this->m_chunkExecutionStates);
   }
+  if (this->m_chunkPendingDependencies != NULL) {
+    MEM_freeN(this->m_chunkPendingDependencies);
+    this->m_chunkPendingDependencies = NULL;
+  }
+  if (this->m_chunkDependents != NULL) {
+    delete[] this->m_chunkDependents;
+    this->m_chunkDependents = NULL;
+  }
   unsigned int index;
   determineNumberOfChunks();
 
@@ -134,6 +153,9 @@ void ExecutionGroup::initExecution()
     for (index = 0; index < this->m_numberOfChunks; index++) {
       this->m_chunkExecutionStates[index] = COM_ES_NOT_SCHEDULED;
     }
+    this->m_chunkPendingDependencies = (unsigned int *)MEM_callocN(
+        sizeof(unsigned int) * this->m_numberOfChunks, __func__);
+    this->m_chunkDependents = new vector<WorkPackage>[this->m_numberOfChunks];
   }
 
   unsigned int maxNumber = 0;
@@ -156,12 +178,40 @@ void ExecutionGroup::deinitExecution()
     MEM_freeN(this->m_chunkExecutionStates);
     this->m_chunkExecutionStates = NULL;
   }
+  if (this->m_chunkPendingDependencies != NULL) {
+    MEM_freeN(this->m_chunkPendingDependencies);
+    this->m_chunkPendingDependencies = NULL;
+  }
+  if (this->m_chunkDependents != NULL) {
+    delete[] this->m_chunkDependents;
+    this->m_chunkDependents = NULL;
+  }
   this->m_numberOfChunks = 0;
   this->m_numberOfXChunks = 0;
   this->m_numberOfYChunks = 0;
   this->m_cachedReadOperations.clear();
   this->m_bTree = NULL;
 }
+void ExecutionGroup::setExecuted()
+{
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+  }
+}
+
+bool ExecutionGroup::isExecuted() const
+{
+  if (this->m_numberOfChunks == 0) {
+    return false;
+  }
+  for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+    if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void ExecutionGroup::determineResolution(unsigned int resolution[2])
 {
   NodeOperation *operation = this->getOutputOperation();
@@ -322,49 +372,27 @@ void ExecutionGroup::execute(ExecutionSystem *graph)
   DebugInfo::execution_group_started(this);
   DebugInfo::graphviz(graph);
 
-  bool breaked = false;
-  bool finished = false;
-  unsigned int startIndex = 0;
-  const int maxNumberEvaluated = BLI_system_thread_count() * 2;
-
-  while (!finished && !breaked) {
-    bool startEvaluated = false;
-    finished = true;
-    int numberEvaluated = 0;
-
-    for (index = startIndex;
-         index < this->m_numberOfChunks && numberEvaluated < maxNumberEvaluated;
-         index++) {
-      chunkNumber = chunkOrder[index];
-      int yChunk = chunkNumber / this->m_numberOfXChunks;
-      int xChunk = chunkNumber - (yChunk * this->m_numberOfXChunks);
-      const ChunkExecutionState state = this->m_chunkExecutionStates[chunkNumber];
-      if (state == COM_ES_NOT_SCHEDULED) {
-        scheduleChunkWhenPossible(graph, xChunk, yChunk);
-        finished = false;
-        startEvaluated = true;
-        numberEvaluated++;
-
-        if (bTree->update_draw) {
-          bTree->update_draw(bTree->udh);
-        }
-      }
-      else if (state == COM_ES_SCHEDULED) {
-        finished = false;
-        startEvaluated = true;
-        numberEvaluated++;
-      }
-      else if (state == COM_ES_EXECUTED && !startEvaluated) {
-        startIndex = index + 1;
-      }
-    }
+  /* Chunks are scheduled in order, each chunk starts as soon as the chunks it depends on are
+   * executed. */
+  vector<WorkPackage> readyPackages;
+  for (index = 0; index < this->m_numberOfChunks; index++) {
+    chunkNumber = chunkOrder[index];
+    int yChunk = chunkNumber / this->m_numberOfXChunks;
+    int xChunk = chunkNumber - (yChunk * this->m_numberOfXChunks);
+
+    BLI_mutex_lock(&g_scheduleMutex);
+    scheduleChunkWhenPossible(graph, xChunk, yChunk, NULL, &readyPackages);
+    BLI_mutex_unlock(&g_scheduleMutex);
 
-    WorkScheduler::finish();
+    scheduleChunks(readyPackages);
+    readyPackages.clear();
 
     if (bTree->test_break && bTree->test_break(bTree->tbh)) {
-      breaked = true;
+      break;
     }
   }
+
+  WorkScheduler::finish(this->m_taskPool);
   DebugInfo::execution_group_finished(this);
   DebugInfo::graphviz(graph);
 
@@ -405,9 +433,24 @@ MemoryBuffer *ExecutionGroup::constructConsolidatedMemoryBuffer(MemoryProxy *mem
 
 void ExecutionGroup::finalizeChunkExecution(int chunkNumber, MemoryBuffer **memoryBuffers)
 {
+  /* Schedule the chunks that were only waiting for this chunk. */
+  vector<WorkPackage> readyPackages;
+  BLI_mutex_lock(&g_scheduleMutex);
   if (this->m_chunkExecutionStates[chunkNumber] == COM_ES_SCHEDULED) {
     this->m_chunkExecutionStates[chunkNumber] = COM_ES_EXECUTED;
   }
+  vector<WorkPackage> &dependents = this->m_chunkDependents[chunkNumber];
+  for (unsigned int index = 0; index < dependents.size(); index++) {
+    const WorkPackage &dependent = dependents[index];
+    ExecutionGroup *group = dependent.getExecutionGroup();
+    if (--group->m_chunkPendingDependencies[dependent.getChunkNumber()] == 0) {
+      readyPackages.push_back(dependent);
+    }
+  }
+  dependents.clear();
+  BLI_mutex_unlock(&g_scheduleMutex);
+
+  scheduleChunks(readyPackages);
 
   atomic_add_and_fetch_u(&this->m_chunksFinished, 1);
   if (memoryBuffers) {
@@ -481,10 +524,13 @@ MemoryBuffer *ExecutionGroup::allocateOutputBuffer(int /*chunkNumber*/, rcti *re
   return NULL;
 }
 
-bool ExecutionGroup::scheduleAreaWhenPossible(ExecutionSystem *graph, rcti *area)
+unsigned int ExecutionGroup::scheduleAreaWhenPossible(ExecutionSystem *graph,
+                                                      rcti *area,
+                                                      WorkPackage *dependent,
+                                                      vector<WorkPackage> *readyPackages)
 {
   if (this->m_singleThreaded) {
-    return scheduleChunkWhenPossible(graph, 0, 0);
+    return scheduleChunkWhenPossible(graph, 0, 0, dependent, readyPackages) ? 1 : 0;
   }
   // find all chunks inside the rect
   // determine minxchunk, minychunk, maxxchunk, maxychunk where x and y are chunknumbers
@@ -503,56 +549,65 @@ bool ExecutionGroup::scheduleAreaWhenPossible(ExecutionSystem *graph, rcti *area
   maxxchunk = min_ii(maxxchunk, (int)m_numberOfXChunks);
   maxychunk = min_ii(maxychunk, (int)m_numberOfYChunks);
 
-  bool result = true;
+  unsigned int numberOfPendingChunks = 0;
   for (indexx = minxchunk; indexx < maxxchunk; indexx++) {
     for (indexy = minychunk; indexy < maxychunk; indexy++) {
-      if (!scheduleChunkWhenPossible(graph, indexx, indexy)) {
-        result = false;
+      if (scheduleChunkWhenPossible(graph, indexx, indexy, dependent, readyPackages)) {
+        numberOfPendingChunks++;
       }
     }
   }
 
-  return result;
+  return numberOfPendingChunks;
 }
 
-bool ExecutionGroup::scheduleChunk(unsigned int chunkNumber)
+void ExecutionGroup::scheduleChunks(const vector<WorkPackage> &packages)
 {
-  if (this->m_chunkExecutionStates[chunkNumber] == COM_ES_NOT_SCHEDULED) {
-    this->m_chunkExecutionStates[chunkNumber] = COM_ES_SCHEDULED;
-    WorkScheduler::schedule(this, chunkNumber);
-    return true;
+  for (unsigned int index = 0; index < packages.size(); index++) {
+    const WorkPackage &package = packages[index];
+    WorkScheduler::schedule(package.getExecutionGroup(), package.getChunkNumber());
   }
-  return false;
 }
 
-bool ExecutionGroup::scheduleChunkWhenPossible(ExecutionSystem *graph, int xChunk, int yChunk)
+bool ExecutionGroup::scheduleChunkWhenPossible(ExecutionSystem *graph,
+                                               int xChunk,
+                                               int yChunk,
+                                               WorkPackage *dependent,
+                                               vector<WorkPackage> *readyPackages)
 {
   if (xChunk < 0 || xChunk >= (int)this->m_numberOfXChunks) {
-    return true;
+    return false;
   }
   if (yChunk < 0 || yChunk >= (int)this->m_numberOfYChunks) {
-    return true;
+    return false;
   }
   int chunkNumber = yChunk * this->m_numberOfXChunks + xChunk;
   // chunk is already executed
   if (this->m_chunkExecutionStates[chunkNumber] == COM_ES_EXECUTED) {
-    return true;
+    return false;
+  }
+
+  if (dependent) {
+    this->m_chunkDependents[chunkNumber].push_back(*dependent);
   }
 
   // chunk is scheduled, but not executed
   if (this->m_chunkExecutionStates[chunkNumber] == COM_ES_SCHEDULED) {
-    return false;
+    return true;
   }
 
-  // chunk is nor executed nor scheduled.
+  // chunk is nor executed nor scheduled, schedule the chunks it depends on first.
+  this->m_chunkExecutionStates[chunkNumber] = COM_ES_SCHEDULED;
+
   vector<MemoryProxy *> memoryProxies;
   this->determineDependingMemoryProxies(&memoryProxies);
 
   rcti rect;
   determineChunkRect(&rect, xChunk, yChunk);
   unsigned int index;
-  bool canBeExecuted = true;
+  unsigned int numberOfPendingChunks = 0;
   rcti area;
+  WorkPackage package(this, chunkNumber);
 
   for (index = 0; index < this->m_cachedReadOperations.size(); index++) {
     ReadBufferOperation *readOperation =
@@ -563,20 +618,20 @@ bool ExecutionGroup::scheduleChunkWhenPossible(ExecutionSystem *graph, int xChun
     ExecutionGroup *group = memoryProxy->getExecutor();
 
     if (group != NULL) {
-      if (!group->scheduleAreaWhenPossible(graph, &area)) {
-        canBeExecuted = false;
-      }
+      numberOfPendingChunks += group->scheduleAreaWhenPossible(
+          graph, &area, &package, readyPackages);
     }
     else {
       throw "ERROR";
     }
   }
 
-  if (canBeExecuted) {
-    scheduleChunk(chunkNumber);
+  this->m_chunkPendingDependencies[chunkNumber] = numberOfPendingChunks;
+  if (numberOfPendingChunks == 0) {
+    readyPackages->push_back(package);
   }
 
-  return false;
+  return true;
 }
 
 void ExecutionGroup::determineDependingAreaOfInterest(rcti *input,
@@ -23,6 +23,7 @@
 #endif
 
 #include "BLI_rect.h"
+#include "BLI_task.h"
 #include "COM_CompositorContext.h"
 #include "COM_Device.h"
 #include "COM_MemoryProxy.h"
@@ -36,6 +37,7 @@ class ExecutionSystem;
 class MemoryProxy;
 class ReadBufferOperation;
 class Device;
+class WorkPackage;
 
 /**
  * \brief the execution state of a chunk in an ExecutionGroup
@@ -48,6 +50,7 @@ typedef enum ChunkExecutionState {
   COM_ES_NOT_SCHEDULED = 0,
   /**
    * \brief chunk is scheduled, but not yet executed
+   * \note it is added to the WorkScheduler once the chunks it depends on are executed
    */
   COM_ES_SCHEDULED = 1,
   /**
@@ -158,6 +161,23 @@ class ExecutionGroup {
    */
   ChunkExecutionState *m_chunkExecutionStates;
 
+  /**
+   * \brief per chunk the number of chunks of other ExecutionGroups that still need to be executed
+   * before the chunk can be added to the WorkScheduler
+   */
+  unsigned int *m_chunkPendingDependencies;
+
+  /**
+   * \brief per chunk the scheduled chunks of other ExecutionGroups waiting for it
+   */
+  vector<WorkPackage> *m_chunkDependents;
+
+  /**
+   * \brief task pool of the execution, the chunks of this ExecutionGroup are scheduled in
+   * \see WorkScheduler.start
+   */
+  TaskPool *m_taskPool;
+
   /**
    * \brief indicator when this ExecutionGroup has valid Operations in its vector for Execution
    * \note When building the ExecutionGroup Operations are added via recursion.
@@ -210,35 +230,42 @@ class ExecutionGroup {
   void determineNumberOfChunks();
 
   /**
-   * \brief try to schedule a specific chunk.
-   * \note scheduling succeeds when all input requirements are met and the chunks hasn't been
-   * scheduled yet.
+   * \brief schedule a specific chunk and the chunks of other ExecutionGroups it depends on.
+   * \note the chunk is added to the WorkScheduler as soon as all chunks it depends on are
+   * executed, until then it is added as dependent to these chunks.
+   * \note caller must hold the scheduling mutex.
    * \param graph:
    * \param xChunk:
    * \param yChunk:
+   * \param dependent: chunk that waits for this chunk, can be NULL
+   * \param readyPackages: chunks that can be added to the WorkScheduler right away
    * \return [true:false]
-   * true: package(s) are scheduled
-   * false: scheduling is deferred (depending workpackages are scheduled)
+   * true: the chunk is not executed yet, dependent will be notified when it is
+   * false: the chunk is already executed (or doesn't exist)
    */
-  bool scheduleChunkWhenPossible(ExecutionSystem *graph, int xChunk, int yChunk);
+  bool scheduleChunkWhenPossible(ExecutionSystem *graph,
+                                 int xChunk,
+                                 int yChunk,
+                                 WorkPackage *dependent,
+                                 vector<WorkPackage> *readyPackages);
 
   /**
-   * \brief try to schedule a specific area.
-   * \note Check if a certain area is available, when not available this are will be checked.
+   * \brief schedule all chunks of a specific area.
    * \note This method is called from other ExecutionGroup's.
-   * \param graph:
-   * \param area:
-   * \return [true:false]
-   * true: package(s) are scheduled
-   * false: scheduling is deferred (depending workpackages are scheduled)
+   * \see scheduleChunkWhenPossible
+   * \return the number of chunks dependent has to wait for
    */
-  bool scheduleAreaWhenPossible(ExecutionSystem *graph, rcti *area);
+  unsigned int scheduleAreaWhenPossible(ExecutionSystem *graph,
+                                        rcti *area,
+                                        WorkPackage *dependent,
+                                        vector<WorkPackage> *readyPackages);
 
   /**
-   * \brief add a chunk to the WorkScheduler.
-   * \param chunknumber:
+   * \brief add chunks of which all dependencies are executed to the WorkScheduler.
+   * \note must be called without holding the scheduling mutex,
+   * the WorkScheduler can execute a chunk in the calling thread.
    */
-  bool scheduleChunk(unsigned int chunkNumber);
+  static void scheduleChunks(const vector<WorkPackage> &packages);
 
   /**
    * \brief determine the area of interest of a certain input area
@@ -381,6 +408,18 @@ class ExecutionGroup {
    */
   void deinitExecution();
 
+  /**
+   * \brief mark all chunks as executed
+   * \note used when the output buffer of this ExecutionGroup is restored from the BufferCache
+   */
+  void setExecuted();
+
+  /**
+   * \brief are all chunks of this ExecutionGroup executed
+   * \note only valid between initExecution and deinitExecution
+   */
+  bool isExecuted() const;
+
   /**
    * \brief schedule an ExecutionGroup
    * \note this method will return when all chunks have been calculated, or the execution has
@@ -425,6 +464,15 @@ class ExecutionGroup {
     this->m_chunkSize = chunksize;
   }
 
+  void setTaskPool(TaskPool *pool)
+  {
+    this->m_taskPool = pool;
+  }
+  TaskPool *getTaskPool() const
+  {
+    return this->m_taskPool;
+  }
+
   /**
    * \brief get the Render priority of this ExecutionGroup
    * \see ExecutionSystem.execute
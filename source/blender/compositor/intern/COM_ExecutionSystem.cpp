@@ -25,6 +25,7 @@
 
 #include "BLT_translation.h"
 
+#include "COM_BufferCache.h"
 #include "COM_Converter.h"
 #include "COM_Debug.h"
 #include "COM_ExecutionGroup.h"
@@ -32,6 +33,7 @@
 #include "COM_NodeOperationBuilder.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_WorkScheduler.h"
+#include "COM_WriteBufferOperation.h"
 
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
@@ -44,10 +46,12 @@ ExecutionSystem::ExecutionSystem(RenderData *rd,
                                  bool fastcalculation,
                                  const ColorManagedViewSettings *viewSettings,
                                  const ColorManagedDisplaySettings *displaySettings,
-                                 const char *viewName)
+                                 const char *viewName,
+                                 Render *render)
 {
   this->m_context.setViewName(viewName);
   this->m_context.setScene(scene);
+  this->m_context.setRender(render);
   this->m_context.setbNodeTree(editingtree);
   this->m_context.setPreviewHash(editingtree->previews);
   this->m_context.setFastCalculation(fastcalculation);
@@ -127,6 +131,26 @@ void ExecutionSystem::set_operations(const Operations &operations, const Groups
   m_groups = groups;
 }
 
+/**
+ * Get the write buffer of an execution group that can be stored in the BufferCache.
+ * Outputs have side effects and single values are cheap to calculate.
+ */
+static WriteBufferOperation *get_cacheable_write_operation(ExecutionGroup *group)
+{
+  if (group->isOutputExecutionGroup()) {
+    return NULL;
+  }
+  NodeOperation *operation = group->getOutputOperation();
+  if (!operation->isWriteBufferOperation()) {
+    return NULL;
+  }
+  WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+  if (writeOperation->isSingleValue()) {
+    return NULL;
+  }
+  return writeOperation;
+}
+
 void ExecutionSystem::execute()
 {
   const bNodeTree *editingtree = this->m_context.getbNodeTree();
@@ -177,7 +201,25 @@ void ExecutionSystem::execute()
     executionGroup->initExecution();
   }
 
-  WorkScheduler::start(this->m_context);
+  /* Reuse the results of unchanged parts of the node tree from earlier executions. Renders
+   * don't use the cache, their buffers are rarely needed again and would push out the buffers of
+   * interactive editing. */
+  const bool use_buffer_cache = !this->m_context.isRendering();
+  BufferCacheKeys cache_keys(this->m_context);
+  for (index = 0; use_buffer_cache && index < this->m_groups.size(); index++) {
+    ExecutionGroup *executionGroup = this->m_groups[index];
+    WriteBufferOperation *writeOperation = get_cacheable_write_operation(executionGroup);
+    uint64_t key;
+    if (writeOperation && cache_keys.get(writeOperation, &key) &&
+        BufferCache::restore(key, writeOperation->getMemoryProxy())) {
+      executionGroup->setExecuted();
+    }
+  }
+
+  TaskPool *pool = WorkScheduler::start(this->m_context);
+  for (index = 0; index < this->m_groups.size(); index++) {
+    this->m_groups[index]->setTaskPool(pool);
+  }
 
   executeGroups(COM_PRIORITY_HIGH);
   if (!this->getContext().isFastCalculation()) {
@@ -185,8 +227,17 @@ void ExecutionSystem::execute()
     executeGroups(COM_PRIORITY_LOW);
   }
 
-  WorkScheduler::finish();
-  WorkScheduler::stop();
+  WorkScheduler::finish(pool);
+  WorkScheduler::stop(pool);
+
+  for (index = 0; use_buffer_cache && index < this->m_groups.size(); index++) {
+    ExecutionGroup *executionGroup = this->m_groups[index];
+    WriteBufferOperation *writeOperation = get_cacheable_write_operation(executionGroup);
+    uint64_t key;
+    if (writeOperation && executionGroup->isExecuted() && cache_keys.get(writeOperation, &key)) {
+      BufferCache::store(key, writeOperation->getMemoryProxy());
+    }
+  }
 
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
   for (index = 0; index < this->m_operations.size(); index++) {
@@ -152,6 +152,7 @@ class ExecutionSystem {
    *
    * \param editingtree: [bNodeTree *]
    * \param rendering: [true false]
+   * \param render: [Render *] receives the composite result, NULL for the render of the scene
    */
   ExecutionSystem(RenderData *rd,
                   Scene *scene,
@@ -160,7 +161,8 @@ class ExecutionSystem {
                   bool fastcalculation,
                   const ColorManagedViewSettings *viewSettings,
                   const ColorManagedDisplaySettings *displaySettings,
-                  const char *viewName);
+                  const char *viewName,
+                  struct Render *render);
 
   /**
    * Destructor
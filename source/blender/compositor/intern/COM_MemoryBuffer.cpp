@@ -41,6 +41,27 @@ unsigned int MemoryBuffer::determineBufferSize()
   return getWidth() * getHeight();
 }
 
+size_t MemoryBuffer::getMemorySize()
+{
+  const size_t element_size = this->m_half_buffer ? sizeof(unsigned short) : sizeof(float);
+  return element_size * this->determineBufferSize() * this->m_num_channels;
+}
+
+void MemoryBuffer::allocateBuffer(bool half_float)
+{
+  const size_t num_elements = (size_t)determineBufferSize() * this->m_num_channels;
+  if (half_float) {
+    this->m_buffer = NULL;
+    this->m_half_buffer = (unsigned short *)MEM_mallocN_aligned(
+        sizeof(unsigned short) * num_elements, 16, "COM_MemoryBuffer half");
+  }
+  else {
+    this->m_buffer = (float *)MEM_mallocN_aligned(
+        sizeof(float) * num_elements, 16, "COM_MemoryBuffer");
+    this->m_half_buffer = NULL;
+  }
+}
+
 int MemoryBuffer::getWidth() const
 {
   return this->m_width;
@@ -58,8 +79,7 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, unsigned int chunkNumber, r
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = chunkNumber;
   this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  allocateBuffer(memoryProxy->isHalfFloat());
   this->m_state = COM_MB_ALLOCATED;
   this->m_datatype = memoryProxy->getDataType();
 }
@@ -72,12 +92,11 @@ MemoryBuffer::MemoryBuffer(MemoryProxy *memoryProxy, rcti *rect)
   this->m_memoryProxy = memoryProxy;
   this->m_chunkNumber = -1;
   this->m_num_channels = determine_num_channels(memoryProxy->getDataType());
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  allocateBuffer(false);
   this->m_state = COM_MB_TEMPORARILY;
   this->m_datatype = memoryProxy->getDataType();
 }
-MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect)
+MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect, bool half_float)
 {
   BLI_rcti_init(&this->m_rect, rect->xmin, rect->xmax, rect->ymin, rect->ymax);
   this->m_width = BLI_rcti_size_x(&this->m_rect);
@@ -86,30 +105,49 @@ MemoryBuffer::MemoryBuffer(DataType dataType, rcti *rect)
   this->m_memoryProxy = NULL;
   this->m_chunkNumber = -1;
   this->m_num_channels = determine_num_channels(dataType);
-  this->m_buffer = (float *)MEM_mallocN_aligned(
-      sizeof(float) * determineBufferSize() * this->m_num_channels, 16, "COM_MemoryBuffer");
+  allocateBuffer(half_float);
   this->m_state = COM_MB_TEMPORARILY;
   this->m_datatype = dataType;
 }
 MemoryBuffer *MemoryBuffer::duplicate()
 {
   MemoryBuffer *result = new MemoryBuffer(this->m_memoryProxy, &this->m_rect);
-  memcpy(result->m_buffer,
-         this->m_buffer,
-         this->determineBufferSize() * this->m_num_channels * sizeof(float));
+  if (this->m_half_buffer) {
+    result->copyContentFrom(this);
+  }
+  else {
+    memcpy(result->m_buffer,
+           this->m_buffer,
+           this->determineBufferSize() * this->m_num_channels * sizeof(float));
+  }
   return result;
 }
 void MemoryBuffer::clear()
 {
-  memset(this->m_buffer, 0, this->determineBufferSize() * this->m_num_channels * sizeof(float));
+  /* zero bits are 0.0f in both float and half float */
+  memset(this->m_buffer ? (void *)this->m_buffer : (void *)this->m_half_buffer,
+         0,
+         this->getMemorySize());
 }
 
 float MemoryBuffer::getMaximumValue()
 {
-  float result = this->m_buffer[0];
   const unsigned int size = this->determineBufferSize();
   unsigned int i;
 
+  if (this->m_half_buffer) {
+    const unsigned short *hp_src = this->m_half_buffer;
+    float result = com_half_to_float(hp_src[0]);
+    for (i = 0; i < size; i++, hp_src += this->m_num_channels) {
+      float value = com_half_to_float(*hp_src);
+      if (value > result) {
+        result = value;
+      }
+    }
+    return result;
+  }
+
+  float result = this->m_buffer[0];
   const float *fp_src = this->m_buffer;
 
   for (i = 0; i < size; i++, fp_src += this->m_num_channels) {
@@ -147,6 +185,10 @@ MemoryBuffer::~MemoryBuffer()
     MEM_freeN(this->m_buffer);
     this->m_buffer = NULL;
   }
+  if (this->m_half_buffer) {
+    MEM_freeN(this->m_half_buffer);
+    this->m_half_buffer = NULL;
+  }
 }
 
 void MemoryBuffer::copyContentFrom(MemoryBuffer *otherBuffer)
@@ -169,9 +211,29 @@ void MemoryBuffer::copyContentFrom(MemoryBuffer *otherBuffer)
                   this->m_num_channels;
     offset = ((otherY - this->m_rect.ymin) * this->m_width + minX - this->m_rect.xmin) *
              this->m_num_channels;
-    memcpy(&this->m_buffer[offset],
-           &otherBuffer->m_buffer[otherOffset],
-           (maxX - minX) * this->m_num_channels * sizeof(float));
+    const unsigned int len = (maxX - minX) * this->m_num_channels;
+    if (this->m_buffer && otherBuffer->m_buffer) {
+      memcpy(&this->m_buffer[offset], &otherBuffer->m_buffer[otherOffset], len * sizeof(float));
+    }
+    else if (this->m_half_buffer && otherBuffer->m_half_buffer) {
+      memcpy(&this->m_half_buffer[offset],
+             &otherBuffer->m_half_buffer[otherOffset],
+             len * sizeof(unsigned short));
+    }
+    else if (this->m_half_buffer) {
+      unsigned short *dst = &this->m_half_buffer[offset];
+      const float *src = &otherBuffer->m_buffer[otherOffset];
+      for (unsigned int i = 0; i < len; i++) {
+        dst[i] = com_float_to_half(src[i]);
+      }
+    }
+    else {
+      float *dst = &this->m_buffer[offset];
+      const unsigned short *src = &otherBuffer->m_half_buffer[otherOffset];
+      for (unsigned int i = 0; i < len; i++) {
+        dst[i] = com_half_to_float(src[i]);
+      }
+    }
   }
 }
 
@@ -181,7 +243,14 @@ void MemoryBuffer::writePixel(int x, int y, const float color[4])
       y < this->m_rect.ymax) {
     const int offset = (this->m_width * (y - this->m_rect.ymin) + x - this->m_rect.xmin) *
                        this->m_num_channels;
-    memcpy(&this->m_buffer[offset], color, sizeof(float) * this->m_num_channels);
+    if (this->m_half_buffer) {
+      for (unsigned int i = 0; i < this->m_num_channels; i++) {
+        this->m_half_buffer[offset + i] = com_float_to_half(color[i]);
+      }
+    }
+    else {
+      memcpy(&this->m_buffer[offset], color, sizeof(float) * this->m_num_channels);
+    }
   }
 }
 
@@ -191,6 +260,13 @@ void MemoryBuffer::addPixel(int x, int y, const float color[4])
       y < this->m_rect.ymax) {
     const int offset = (this->m_width * (y - this->m_rect.ymin) + x - this->m_rect.xmin) *
                        this->m_num_channels;
+    if (this->m_half_buffer) {
+      unsigned short *dst = &this->m_half_buffer[offset];
+      for (unsigned int i = 0; i < this->m_num_channels; i++) {
+        dst[i] = com_float_to_half(com_half_to_float(dst[i]) + color[i]);
+      }
+      return;
+    }
     float *dst = &this->m_buffer[offset];
     const float *src = color;
     for (int i = 0; i < this->m_num_channels; i++, dst++, src++) {
@@ -199,6 +275,91 @@ void MemoryBuffer::addPixel(int x, int y, const float color[4])
   }
 }
 
+void MemoryBuffer::writeSpan(int x, int y, int width, const float *span)
+{
+  BLI_assert(x >= this->m_rect.xmin && x + width <= this->m_rect.xmax && y >= this->m_rect.ymin &&
+             y < this->m_rect.ymax);
+  const int offset = (this->m_width * (y - this->m_rect.ymin) + x - this->m_rect.xmin) *
+                     this->m_num_channels;
+  const unsigned int num_channels = this->m_num_channels;
+
+  if (this->m_half_buffer) {
+    unsigned short *dst = &this->m_half_buffer[offset];
+    for (int i = 0; i < width; i++, dst += num_channels, span += COM_NUM_CHANNELS_COLOR) {
+      for (unsigned int c = 0; c < num_channels; c++) {
+        dst[c] = com_float_to_half(span[c]);
+      }
+    }
+  }
+  else if (num_channels == COM_NUM_CHANNELS_COLOR) {
+    memcpy(&this->m_buffer[offset], span, sizeof(float) * width * COM_NUM_CHANNELS_COLOR);
+  }
+  else {
+    float *dst = &this->m_buffer[offset];
+    for (int i = 0; i < width; i++, dst += num_channels, span += COM_NUM_CHANNELS_COLOR) {
+      memcpy(dst, span, sizeof(float) * num_channels);
+    }
+  }
+}
+
+void MemoryBuffer::readBilinearHalf(float *result, float u, float v, bool wrap_x, bool wrap_y)
+{
+  /* Same sampling as BLI_bilinear_interpolation_wrap_fl, converting the four texels. */
+  const int width = this->m_width;
+  const int height = this->m_height;
+  const unsigned int num_channels = this->m_num_channels;
+  int x1 = (int)floorf(u);
+  int x2 = (int)ceilf(u);
+  int y1 = (int)floorf(v);
+  int y2 = (int)ceilf(v);
+
+  if (wrap_x) {
+    if (x1 < 0) {
+      x1 = width - 1;
+    }
+    if (x2 >= width) {
+      x2 = 0;
+    }
+  }
+  else if (x2 < 0 || x1 >= width) {
+    copy_vn_fl(result, num_channels, 0.0f);
+    return;
+  }
+
+  if (wrap_y) {
+    if (y1 < 0) {
+      y1 = height - 1;
+    }
+    if (y2 >= height) {
+      y2 = 0;
+    }
+  }
+  else if (y2 < 0 || y1 >= height) {
+    copy_vn_fl(result, num_channels, 0.0f);
+    return;
+  }
+
+  const int xs[4] = {x1, x1, x2, x2};
+  const int ys[4] = {y1, y2, y1, y2};
+  const float a = u - floorf(u);
+  const float b = v - floorf(v);
+  const float weights[4] = {
+      (1.0f - a) * (1.0f - b), (1.0f - a) * b, a * (1.0f - b), a * b};
+
+  copy_vn_fl(result, num_channels, 0.0f);
+  for (int i = 0; i < 4; i++) {
+    /* sample including outside of edges of image */
+    if (xs[i] < 0 || xs[i] > width - 1 || ys[i] < 0 || ys[i] > height - 1) {
+      continue;
+    }
+    const unsigned short *texel =
+        &this->m_half_buffer[(width * ys[i] + xs[i]) * num_channels];
+    for (unsigned int c = 0; c < num_channels; c++) {
+      result[c] += weights[i] * com_half_to_float(texel[c]);
+    }
+  }
+}
+
 static void read_ewa_pixel_sampled(void *userdata, int x, int y, float result[4])
 {
   MemoryBuffer *buffer = (MemoryBuffer *)userdata;
@@ -49,6 +49,84 @@ typedef enum MemoryBufferExtend {
 
 class MemoryProxy;
 
+/**
+ * \brief convert a float to an IEEE half float, rounding to nearest even
+ * values outside the half float range become infinite
+ */
+inline unsigned short com_float_to_half(float value)
+{
+  union {
+    float f;
+    uint32_t u;
+  } bits;
+  bits.f = value;
+  const unsigned short sign = (bits.u >> 16) & 0x8000;
+  const uint32_t u = bits.u & 0x7fffffff;
+
+  if (u >= 0x47800000) {
+    /* overflow, infinity or nan */
+    return sign | (u > 0x7f800000 ? 0x7e00 : 0x7c00);
+  }
+  if (u < 0x38800000) {
+    /* denormal or zero */
+    if (u < 0x33000000) {
+      return sign;
+    }
+    const uint32_t shift = 126 - (u >> 23);
+    const uint32_t mantissa = (u & 0x7fffff) | 0x800000;
+    const uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const uint32_t halfway = 1u << (shift - 1);
+    uint32_t h = mantissa >> shift;
+    if (remainder > halfway || (remainder == halfway && (h & 1))) {
+      h++;
+    }
+    return sign | h;
+  }
+
+  /* rebias the exponent, a carry out of the mantissa correctly rounds up to infinity */
+  uint32_t h = (u - 0x38000000) >> 13;
+  const uint32_t remainder = u & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (h & 1))) {
+    h++;
+  }
+  return sign | h;
+}
+
+/**
+ * \brief convert an IEEE half float to a float
+ */
+inline float com_half_to_float(unsigned short value)
+{
+  union {
+    float f;
+    uint32_t u;
+  } bits;
+  const uint32_t sign = (uint32_t)(value & 0x8000) << 16;
+  uint32_t exponent = (value >> 10) & 0x1f;
+  uint32_t mantissa = value & 0x3ff;
+
+  if (exponent == 0) {
+    if (mantissa == 0) {
+      bits.u = sign;
+      return bits.f;
+    }
+    /* normalize denormal */
+    exponent = 113;
+    while (!(mantissa & 0x400)) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits.u = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+  else if (exponent == 31) {
+    bits.u = sign | 0x7f800000 | (mantissa << 13);
+  }
+  else {
+    bits.u = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  }
+  return bits.f;
+}
+
 /**
  * \brief a MemoryBuffer contains access to the data of a chunk
  */
@@ -85,6 +163,12 @@ class MemoryBuffer {
    */
   float *m_buffer;
 
+  /**
+   * \brief half float buffer/data, used instead of m_buffer when the MemoryProxy
+   * requests half float storage.
+   */
+  unsigned short *m_half_buffer;
+
   /**
    * \brief the number of channels of a single value in the buffer.
    * For value buffers this is 1, vector 3 and color 4
@@ -108,7 +192,7 @@ class MemoryBuffer {
   /**
    * \brief construct new temporarily MemoryBuffer for an area
    */
-  MemoryBuffer(DataType datatype, rcti *rect);
+  MemoryBuffer(DataType datatype, rcti *rect, bool half_float = false);
 
   /**
    * \brief destructor
@@ -131,12 +215,28 @@ class MemoryBuffer {
   /**
    * \brief get the data of this MemoryBuffer
    * \note buffer should already be available in memory
+   * \note not available for half float buffers, these can only be accessed through
+   * read methods that convert on the fly
    */
   float *getBuffer()
   {
+    BLI_assert(this->m_buffer != NULL);
     return this->m_buffer;
   }
 
+  /**
+   * \brief is the data stored as half float
+   */
+  bool isHalfFloat() const
+  {
+    return this->m_half_buffer != NULL;
+  }
+
+  /**
+   * \brief size in bytes of the data of this MemoryBuffer
+   */
+  size_t getMemorySize();
+
   /**
    * \brief after execution the state will be set to available by calling this method
    */
@@ -245,8 +345,7 @@ class MemoryBuffer {
       int v = y;
       this->wrap_pixel(u, v, extend_x, extend_y);
       const int offset = (this->m_width * y + x) * this->m_num_channels;
-      float *buffer = &this->m_buffer[offset];
-      memcpy(result, buffer, sizeof(float) * this->m_num_channels);
+      readOffset(result, offset);
     }
   }
 
@@ -271,12 +370,18 @@ class MemoryBuffer {
     BLI_assert((int)(MEM_allocN_len(this->m_buffer) / sizeof(*this->m_buffer)) ==
                (int)(this->determineBufferSize() * COM_NUMBER_OF_CHANNELS));
 #endif
-    float *buffer = &this->m_buffer[offset];
-    memcpy(result, buffer, sizeof(float) * this->m_num_channels);
+    readOffset(result, offset);
   }
 
   void writePixel(int x, int y, const float color[4]);
   void addPixel(int x, int y, const float color[4]);
+
+  /**
+   * \brief write a span of pixels in float[4] layout, as calculated by NodeOperation.readSpanSampled
+   * only the channels of this buffer are stored
+   */
+  void writeSpan(int x, int y, int width, const float *span);
+
   inline void readBilinear(float *result,
                            float x,
                            float y,
@@ -291,6 +396,10 @@ class MemoryBuffer {
       copy_vn_fl(result, this->m_num_channels, 0.0f);
       return;
     }
+    if (this->m_half_buffer) {
+      readBilinearHalf(result, u, v, extend_x == COM_MB_REPEAT, extend_y == COM_MB_REPEAT);
+      return;
+    }
     BLI_bilinear_interpolation_wrap_fl(this->m_buffer,
                                        result,
                                        this->m_width,
@@ -352,6 +461,22 @@ class MemoryBuffer {
  private:
   unsigned int determineBufferSize();
 
+  inline void readOffset(float *result, int offset)
+  {
+    if (this->m_half_buffer) {
+      const unsigned short *buffer = &this->m_half_buffer[offset];
+      for (unsigned int i = 0; i < this->m_num_channels; i++) {
+        result[i] = com_half_to_float(buffer[i]);
+      }
+    }
+    else {
+      memcpy(result, &this->m_buffer[offset], sizeof(float) * this->m_num_channels);
+    }
+  }
+
+  void readBilinearHalf(float *result, float u, float v, bool wrap_x, bool wrap_y);
+  void allocateBuffer(bool half_float);
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:MemoryBuffer")
 #endif
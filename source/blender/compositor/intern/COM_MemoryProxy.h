@@ -64,6 +64,11 @@ class MemoryProxy {
    */
   DataType m_datatype;
 
+  /**
+   * \brief store the allocated memory as half float
+   */
+  bool m_half_float;
+
  public:
   MemoryProxy(DataType type);
 
@@ -125,6 +130,20 @@ class MemoryProxy {
     return this->m_datatype;
   }
 
+  /**
+   * \brief store the buffer as half float, only allowed when no reader needs raw float access
+   * \see MemoryBuffer.isHalfFloat
+   */
+  void setHalfFloat(bool half_float)
+  {
+    this->m_half_float = half_float;
+  }
+
+  bool isHalfFloat() const
+  {
+    return this->m_half_float;
+  }
+
 #ifdef WITH_CXX_GUARDEDALLOC
   MEM_CXX_CLASS_ALLOC_FUNCS("COM:MemoryProxy")
 #endif
@@ -37,6 +37,7 @@ using std::list;
 using std::max;
 using std::min;
 
+class CacheHash;
 class OpenCLDevice;
 class ReadBufferOperation;
 class WriteBufferOperation;
@@ -123,6 +124,17 @@ class NodeOperation : public SocketReader {
    */
   bool m_isResolutionSet;
 
+  /**
+   * \brief hash of the settings of the node this operation was created for
+   * \see BufferCache.hashNode
+   */
+  uint64_t m_settingsHash;
+
+  /**
+   * \brief does this operation read data from outside the node tree (images, render results)
+   */
+  bool m_readsExternalData;
+
  public:
   virtual ~NodeOperation();
 
@@ -365,6 +377,31 @@ class NodeOperation : public SocketReader {
     return true;
   }
 
+  void setSettingsHash(uint64_t hash, bool readsExternalData)
+  {
+    this->m_settingsHash = hash;
+    this->m_readsExternalData = readsExternalData;
+  }
+  uint64_t getSettingsHash() const
+  {
+    return this->m_settingsHash;
+  }
+  bool readsExternalData() const
+  {
+    return this->m_readsExternalData;
+  }
+
+  /**
+   * \brief add the external data read by this operation to the hash of its result
+   * \note only called after initExecution, for operations that read external data.
+   * \return false when the data can't be hashed, the result is not cached then.
+   * \see BufferCache
+   */
+  virtual bool hashExternalData(CacheHash * /*hash*/)
+  {
+    return false;
+  }
+
   inline bool isBraked() const
   {
     return this->m_btree->test_break(this->m_btree->tbh);
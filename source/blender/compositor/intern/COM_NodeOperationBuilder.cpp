@@ -18,6 +18,9 @@
 
 #include "BLI_utildefines.h"
 
+#include "BKE_node.h"
+
+#include "COM_BufferCache.h"
 #include "COM_Converter.h"
 #include "COM_Debug.h"
 #include "COM_ExecutionSystem.h"
@@ -107,6 +110,10 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
   /* surround complex ops with read/write buffer */
   add_complex_operation_buffers();
 
+  if (m_context->isHalfBufferEnabled()) {
+    add_half_float_buffers();
+  }
+
   /* links not available from here on */
   /* XXX make m_links a local variable to avoid confusion! */
   m_links.clear();
@@ -125,6 +132,13 @@ void NodeOperationBuilder::convertToOperations(ExecutionSystem *system)
 
 void NodeOperationBuilder::addOperation(NodeOperation *operation)
 {
+  if (m_current_node) {
+    /* Operations only depend on the settings of the node they are created for,
+     * unless the node refers to external data. Defocus reads the scene camera. */
+    const bNode *b_node = m_current_node->getbNode();
+    operation->setSettingsHash(BufferCache::hashNode(b_node),
+                               b_node->id != NULL || b_node->type == CMP_NODE_DEFOCUS);
+  }
   m_operations.push_back(operation);
 }
 
@@ -597,6 +611,38 @@ void NodeOperationBuilder::add_complex_operation_buffers()
   }
 }
 
+void NodeOperationBuilder::add_half_float_buffers()
+{
+  /* Complex and OpenCL operations get direct access to the float data of their input buffers,
+   * and OpenCL operations write float data to their output buffers. Only buffers that are
+   * exclusively sampled and written on the CPU can be stored as half float. */
+  std::set<MemoryProxy *> float_proxies;
+  for (Links::const_iterator it = m_links.begin(); it != m_links.end(); ++it) {
+    const Link &link = *it;
+    NodeOperation &from = link.from()->getOperation();
+    NodeOperation &to = link.to()->getOperation();
+    if (from.isReadBufferOperation() && (to.isComplex() || to.isOpenCL())) {
+      float_proxies.insert(((ReadBufferOperation &)from).getMemoryProxy());
+    }
+    else if (to.isWriteBufferOperation() && from.isOpenCL()) {
+      float_proxies.insert(((WriteBufferOperation &)to).getMemoryProxy());
+    }
+  }
+
+  for (Operations::const_iterator it = m_operations.begin(); it != m_operations.end(); ++it) {
+    NodeOperation *op = *it;
+    if (!op->isWriteBufferOperation()) {
+      continue;
+    }
+    MemoryProxy *memproxy = ((WriteBufferOperation *)op)->getMemoryProxy();
+    /* Colors keep full precision, mattes and vectors are stored as half float. */
+    if (memproxy->getDataType() != COM_DT_COLOR &&
+        float_proxies.find(memproxy) == float_proxies.end()) {
+      memproxy->setHalfFloat(true);
+    }
+  }
+}
+
 typedef std::set<NodeOperation *> Tags;
 
 static void find_reachable_operations_recursive(Tags &reachable, NodeOperation *op)
@@ -157,6 +157,8 @@ class NodeOperationBuilder {
   void add_complex_operation_buffers();
   void add_input_buffers(NodeOperation *operation, NodeOperationInput *input);
   void add_output_buffers(NodeOperation *operation, NodeOperationOutput *output);
+  /** Store buffers that are only sampled as half float */
+  void add_half_float_buffers();
 
   /** Remove unreachable operations */
   void prune_operations();
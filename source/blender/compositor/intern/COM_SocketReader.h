@@ -79,6 +79,25 @@ class SocketReader {
     executePixelSampled(output, x, y, COM_PS_NEAREST);
   }
 
+  /**
+   * \brief calculate a span of pixels in a row
+   * \note this method is called for non-complex
+   * \param output: is a float array of width * COM_NUM_CHANNELS_COLOR elements to store the
+   * result, every pixel uses the same float[4] layout as in executePixelSampled
+   * \param x: the x-coordinate of the first pixel to calculate in image space
+   * \param y: the y-coordinate of the pixels to calculate in image space
+   * \param width: the number of pixels to calculate, at most COM_SPAN_MAX_WIDTH
+   *
+   * The default implementation calculates the pixels one by one with nearest sampling,
+   * operations can override it to process the whole span in a single loop.
+   */
+  virtual void executeSpanSampled(float *output, int x, int y, int width)
+  {
+    for (int i = 0; i < width; i++) {
+      executePixelSampled(output + i * COM_NUM_CHANNELS_COLOR, x + i, y, COM_PS_NEAREST);
+    }
+  }
+
   /**
    * \brief calculate a single pixel using an EWA filter
    * \note this method is called for complex
@@ -99,6 +118,10 @@ class SocketReader {
   {
     executePixelSampled(result, x, y, sampler);
   }
+  inline void readSpanSampled(float *result, int x, int y, int width)
+  {
+    executeSpanSampled(result, x, y, width);
+  }
   inline void read(float result[4], int x, int y, void *chunkData)
   {
     executePixel(result, x, y, chunkData);
@@ -16,6 +16,7 @@
  * Copyright 2011, Blender Foundation.
  */
 
+#include <deque>
 #include <list>
 #include <stdio.h>
 
@@ -29,32 +30,29 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "PIL_time.h"
 
+#include "atomic_ops.h"
+
 #include "BKE_global.h"
+#include "BKE_scene.h"
 
 #if COM_CURRENT_THREADING_MODEL == COM_TM_NOTHREAD
 #  ifndef DEBUG /* test this so we dont get warnings in debug builds */
 #    warning COM_CURRENT_THREADING_MODEL COM_TM_NOTHREAD is activated. Use only for debugging.
 #  endif
-#elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 /* do nothing - default */
 #else
 #  error COM_CURRENT_THREADING_MODEL No threading model selected
 #endif
 
-/** \brief list of all CPUDevices. for every hardware thread an instance of CPUDevice is created */
-static vector<CPUDevice *> g_cpudevices;
-static ThreadLocal(CPUDevice *) g_thread_device;
-
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-/** \brief list of all thread for every CPUDevice in cpudevices a thread exists. */
-static ListBase g_cputhreads;
-static bool g_cpuInitialized = false;
-/** \brief all scheduled work for the cpu */
-static ThreadQueue *g_cpuqueue;
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 static ThreadQueue *g_gpuqueue;
+/** \brief number of work packages added to the gpu queue that are not finished yet */
+static unsigned int g_gpuPending = 0;
 #  ifdef COM_OPENCL_ENABLED
 static cl_context g_context;
 static cl_program g_program;
@@ -69,18 +67,80 @@ static bool g_openclInitialized = false;
 #  endif
 #endif
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-void *WorkScheduler::thread_execute_cpu(void *data)
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+/**
+ * \brief CPU work of a single execution.
+ * Work is queued here instead of being pushed to the task pool directly, so the number of
+ * tasks executing it can be limited to the number of render threads.
+ */
+typedef struct CPUExecution {
+  const bNodeTree *btree;
+  ThreadMutex mutex;
+  std::deque<WorkPackage *> queue;
+  int num_threads;
+  int num_running;
+} CPUExecution;
+
+/** \brief thread ids that are not used by a running task, and the number of ids handed out. */
+static ThreadMutex g_thread_ids_mutex = BLI_MUTEX_INITIALIZER;
+static vector<int> g_free_thread_ids;
+static int g_num_thread_ids = 0;
+/** \brief id of the task running on this thread, 0 outside of compositor tasks. */
+static thread_local int t_thread_id = 0;
+
+static int thread_id_acquire()
 {
-  CPUDevice *device = (CPUDevice *)data;
-  WorkPackage *work;
-  BLI_thread_local_set(g_thread_device, device);
-  while ((work = (WorkPackage *)BLI_thread_queue_pop(g_cpuqueue))) {
-    device->execute(work);
+  int thread_id;
+  BLI_mutex_lock(&g_thread_ids_mutex);
+  if (g_free_thread_ids.empty()) {
+    thread_id = g_num_thread_ids++;
+  }
+  else {
+    thread_id = g_free_thread_ids.back();
+    g_free_thread_ids.pop_back();
+  }
+  BLI_mutex_unlock(&g_thread_ids_mutex);
+  BLI_assert(thread_id < BLENDER_MAX_THREADS);
+  return thread_id;
+}
+
+static void thread_id_release(int thread_id)
+{
+  BLI_mutex_lock(&g_thread_ids_mutex);
+  g_free_thread_ids.push_back(thread_id);
+  BLI_mutex_unlock(&g_thread_ids_mutex);
+}
+
+void WorkScheduler::thread_execute_cpu(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  CPUExecution *execution = (CPUExecution *)BLI_task_pool_user_data(pool);
+  const bNodeTree *btree = execution->btree;
+
+  /* Without TBB tasks run on the thread pushing them, which may be running another task. */
+  const int previous_thread_id = t_thread_id;
+  t_thread_id = thread_id_acquire();
+  CPUDevice device(t_thread_id);
+
+  while (true) {
+    BLI_mutex_lock(&execution->mutex);
+    if (execution->queue.empty()) {
+      execution->num_running--;
+      BLI_mutex_unlock(&execution->mutex);
+      break;
+    }
+    WorkPackage *work = execution->queue.front();
+    execution->queue.pop_front();
+    BLI_mutex_unlock(&execution->mutex);
+
+    /* Skip remaining work when the user breaks, chunks depending on it are never scheduled. */
+    if (!(btree->test_break && btree->test_break(btree->tbh))) {
+      device.execute(work);
+    }
     delete work;
   }
 
-  return NULL;
+  thread_id_release(t_thread_id);
+  t_thread_id = previous_thread_id;
 }
 
 void *WorkScheduler::thread_execute_gpu(void *data)
@@ -91,6 +151,7 @@ void *WorkScheduler::thread_execute_gpu(void *data)
   while ((work = (WorkPackage *)BLI_thread_queue_pop(g_gpuqueue))) {
     device->execute(work);
     delete work;
+    atomic_sub_and_fetch_u(&g_gpuPending, 1);
   }
 
   return NULL;
@@ -104,31 +165,42 @@ void WorkScheduler::schedule(ExecutionGroup *group, int chunkNumber)
   CPUDevice device(0);
   device.execute(package);
   delete package;
-#elif COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#elif COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 #  ifdef COM_OPENCL_ENABLED
   if (group->isOpenCL() && g_openclActive) {
+    atomic_add_and_fetch_u(&g_gpuPending, 1);
     BLI_thread_queue_push(g_gpuqueue, package);
+    return;
   }
-  else {
-    BLI_thread_queue_push(g_cpuqueue, package);
-  }
-#  else
-  BLI_thread_queue_push(g_cpuqueue, package);
 #  endif
+  TaskPool *pool = group->getTaskPool();
+  CPUExecution *execution = (CPUExecution *)BLI_task_pool_user_data(pool);
+  BLI_mutex_lock(&execution->mutex);
+  execution->queue.push_back(package);
+  const bool start_task = execution->num_running < execution->num_threads;
+  if (start_task) {
+    execution->num_running++;
+  }
+  BLI_mutex_unlock(&execution->mutex);
+
+  if (start_task) {
+    BLI_task_pool_push(pool, thread_execute_cpu, NULL, false, NULL);
+  }
 #endif
 }
 
-void WorkScheduler::start(CompositorContext &context)
+TaskPool *WorkScheduler::start(CompositorContext &context)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-  unsigned int index;
-  g_cpuqueue = BLI_thread_queue_init();
-  BLI_threadpool_init(&g_cputhreads, thread_execute_cpu, g_cpudevices.size());
-  for (index = 0; index < g_cpudevices.size(); index++) {
-    Device *device = g_cpudevices[index];
-    BLI_threadpool_insert(&g_cputhreads, device);
-  }
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  /* All work of this execution on the cpu, executed by the threads of the BLI_task scheduler. */
+  CPUExecution *execution = new CPUExecution();
+  execution->btree = context.getbNodeTree();
+  BLI_mutex_init(&execution->mutex);
+  execution->num_threads = BKE_render_num_threads(context.getRenderData());
+  execution->num_running = 0;
+  TaskPool *pool = BLI_task_pool_create(execution, TASK_PRIORITY_HIGH);
 #  ifdef COM_OPENCL_ENABLED
+  unsigned int index;
   if (context.getHasActiveOpenCLDevices()) {
     g_gpuqueue = BLI_thread_queue_init();
     BLI_threadpool_init(&g_gputhreads, thread_execute_gpu, g_gpudevices.size());
@@ -142,31 +214,47 @@ void WorkScheduler::start(CompositorContext &context)
     g_openclActive = false;
   }
 #  endif
+  return pool;
+#else
+  UNUSED_VARS(context);
+  return NULL;
 #endif
 }
-void WorkScheduler::finish()
+void WorkScheduler::finish(TaskPool *pool)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 #  ifdef COM_OPENCL_ENABLED
   if (g_openclActive) {
-    BLI_thread_queue_wait_finish(g_gpuqueue);
-    BLI_thread_queue_wait_finish(g_cpuqueue);
-  }
-  else {
-    BLI_thread_queue_wait_finish(g_cpuqueue);
+    /* Chunks finished on the GPU can schedule chunks on the CPU and the other way around.
+     * Work is done when the CPU pool is empty while no GPU work was pending before. */
+    while (true) {
+      const bool gpuIdle = atomic_add_and_fetch_u(&g_gpuPending, 0) == 0;
+      BLI_task_pool_work_and_wait(pool);
+      if (gpuIdle && atomic_add_and_fetch_u(&g_gpuPending, 0) == 0) {
+        break;
+      }
+      BLI_thread_queue_wait_finish(g_gpuqueue);
+      PIL_sleep_ms(1);
+    }
+    return;
   }
-#  else
-  BLI_thread_queue_wait_finish(cpuqueue);
 #  endif
+  BLI_task_pool_work_and_wait(pool);
+#else
+  UNUSED_VARS(pool);
 #endif
 }
-void WorkScheduler::stop()
+void WorkScheduler::stop(TaskPool *pool)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-  BLI_thread_queue_nowait(g_cpuqueue);
-  BLI_threadpool_end(&g_cputhreads);
-  BLI_thread_queue_free(g_cpuqueue);
-  g_cpuqueue = NULL;
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  CPUExecution *execution = (CPUExecution *)BLI_task_pool_user_data(pool);
+  BLI_task_pool_free(pool);
+  /* Work left after a user break. */
+  for (WorkPackage *work : execution->queue) {
+    delete work;
+  }
+  BLI_mutex_end(&execution->mutex);
+  delete execution;
 #  ifdef COM_OPENCL_ENABLED
   if (g_openclActive) {
     BLI_thread_queue_nowait(g_gpuqueue);
@@ -175,12 +263,14 @@ void WorkScheduler::stop()
     g_gpuqueue = NULL;
   }
 #  endif
+#else
+  UNUSED_VARS(pool);
 #endif
 }
 
 bool WorkScheduler::hasGPUDevices()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 #  ifdef COM_OPENCL_ENABLED
   return !g_gpudevices.empty();
 #  else
@@ -191,7 +281,7 @@ bool WorkScheduler::hasGPUDevices()
 #endif
 }
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 static void CL_CALLBACK clContextError(const char *errinfo,
                                        const void * /*private_info*/,
                                        size_t /*cb*/,
@@ -201,36 +291,9 @@ static void CL_CALLBACK clContextError(const char *errinfo,
 }
 #endif
 
-void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
+void WorkScheduler::initialize(bool use_opencl)
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-  /* deinitialize if number of threads doesn't match */
-  if (g_cpudevices.size() != num_cpu_threads) {
-    Device *device;
-
-    while (!g_cpudevices.empty()) {
-      device = g_cpudevices.back();
-      g_cpudevices.pop_back();
-      device->deinitialize();
-      delete device;
-    }
-    if (g_cpuInitialized) {
-      BLI_thread_local_delete(g_thread_device);
-    }
-    g_cpuInitialized = false;
-  }
-
-  /* initialize CPU threads */
-  if (!g_cpuInitialized) {
-    for (int index = 0; index < num_cpu_threads; index++) {
-      CPUDevice *device = new CPUDevice(index);
-      device->initialize();
-      g_cpudevices.push_back(device);
-    }
-    BLI_thread_local_create(g_thread_device);
-    g_cpuInitialized = true;
-  }
-
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 #  ifdef COM_OPENCL_ENABLED
   /* deinitialize OpenCL GPU's */
   if (use_opencl && !g_openclInitialized) {
@@ -325,20 +388,7 @@ void WorkScheduler::initialize(bool use_opencl, int num_cpu_threads)
 
 void WorkScheduler::deinitialize()
 {
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
-  /* deinitialize CPU threads */
-  if (g_cpuInitialized) {
-    Device *device;
-    while (!g_cpudevices.empty()) {
-      device = g_cpudevices.back();
-      g_cpudevices.pop_back();
-      device->deinitialize();
-      delete device;
-    }
-    BLI_thread_local_delete(g_thread_device);
-    g_cpuInitialized = false;
-  }
-
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
 #  ifdef COM_OPENCL_ENABLED
   /* deinitialize OpenCL GPU's */
   if (g_openclInitialized) {
@@ -366,6 +416,9 @@ void WorkScheduler::deinitialize()
 
 int WorkScheduler::current_thread_id()
 {
-  CPUDevice *device = (CPUDevice *)BLI_thread_local_get(g_thread_device);
-  return device->thread_id();
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
+  return t_thread_id;
+#else
+  return 0;
+#endif
 }
@@ -20,6 +20,7 @@
 
 #include "COM_ExecutionGroup.h"
 
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "COM_Device.h"
@@ -31,17 +32,14 @@
  */
 class WorkScheduler {
 
-#if COM_CURRENT_THREADING_MODEL == COM_TM_QUEUE
+#if COM_CURRENT_THREADING_MODEL == COM_TM_TASK
   /**
-   * \brief are we being stopped.
+   * \brief task executing the WorkPackages of an execution on the CPU
+   * the task keeps executing queued work until the queue is empty, at most the number of
+   * render threads of the execution run at the same time. A CPUDevice is created with a thread
+   * id that is unique among all running tasks.
    */
-  static bool isStopping();
-
-  /**
-   * \brief main thread loop for cpudevices
-   * inside this loop new work is queried and being executed
-   */
-  static void *thread_execute_cpu(void *data);
+  static void thread_execute_cpu(TaskPool *__restrict pool, void *taskdata);
 
   /**
    * \brief main thread loop for gpudevices
@@ -54,8 +52,9 @@ class WorkScheduler {
    * \brief schedule a chunk of a group to be calculated.
    * An execution group schedules a chunk in the WorkScheduler
    * when ExecutionGroup.isOpenCL is set the work will be handled by a OpenCLDevice
-   * otherwise the work is scheduled for an CPUDevice
+   * otherwise the work is scheduled for an CPUDevice, in the task pool of the group
    * \see ExecutionGroup.execute
+   * \see ExecutionGroup.setTaskPool
    * \param group: the execution group
    * \param chunkNumber: the number of the chunk in the group to be executed
    */
@@ -64,16 +63,13 @@ class WorkScheduler {
   /**
    * \brief initialize the WorkScheduler
    *
-   * during initialization the mutexes are initialized.
-   * there are two mutexes (for every device type one)
-   * After mutex initialization the system is queried in order to count the number of CPUDevices
-   * and GPUDevices to be created. For every hardware thread a CPUDevice and for every OpenCL GPU
-   * device a OpenCLDevice is created. these devices are stored in a separate list (cpudevices &
-   * gpudevices)
+   * CPU work is executed by the threads of the BLI_task scheduler, shared with the rest of
+   * Blender. For every OpenCL GPU device a OpenCLDevice is created and stored in a list
+   * (gpudevices).
    *
    * This function can be called multiple times to lazily initialize OpenCL.
    */
-  static void initialize(bool use_opencl, int num_cpu_threads);
+  static void initialize(bool use_opencl);
 
   /**
    * \brief deinitialize the WorkScheduler
@@ -83,23 +79,28 @@ class WorkScheduler {
 
   /**
    * \brief Start the execution
-   * this methods will start the WorkScheduler. Inside this method all threads are initialized.
-   * for every device a thread is created.
+   * this methods will start the WorkScheduler. Inside this method the task pool for the CPU is
+   * created and for every GPU device a thread is created.
+   *
+   * Every execution has its own task pool, so multiple executions can run at the same time.
+   * The CPU work of an execution uses as many threads as set for rendering in the render data.
+   * OpenCL devices can only be used by one execution at a time.
    * \see initialize Initialization and query of the number of devices
+   * \return the task pool the CPU work of this execution is scheduled in
    */
-  static void start(CompositorContext &context);
+  static TaskPool *start(CompositorContext &context);
 
   /**
    * \brief stop the execution
-   * All created thread by the start method are destroyed.
+   * The task pool and all threads created by the start method are destroyed.
    * \see start
    */
-  static void stop();
+  static void stop(TaskPool *pool);
 
   /**
-   * \brief wait for all work to be completed.
+   * \brief wait for all work in the task pool of an execution to be completed.
    */
-  static void finish();
+  static void finish(TaskPool *pool);
 
   /**
    * \brief Are there OpenCL capable GPU devices initialized?
@@ -109,6 +110,10 @@ class WorkScheduler {
    */
   static bool hasGPUDevices();
 
+  /**
+   * \brief id of the thread executing the current WorkPackage on the CPU.
+   * Ids are unique among all threads executing compositor work at the same time.
+   */
   static int current_thread_id();
 
 #ifdef WITH_CXX_GUARDEDALLOC
@@ -21,8 +21,8 @@
 #include "BLT_translation.h"
 
 #include "BKE_node.h"
-#include "BKE_scene.h"
 
+#include "COM_BufferCache.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_MovieDistortionOperation.h"
 #include "COM_WorkScheduler.h"
@@ -78,7 +78,7 @@ void COM_execute(RenderData *rd,
 
   /* initialize workscheduler, will check if already done. TODO deinitialize somewhere */
   bool use_opencl = (editingtree->flag & NTREE_COM_OPENCL) != 0;
-  WorkScheduler::initialize(use_opencl, BKE_render_num_threads(rd));
+  WorkScheduler::initialize(use_opencl);
 
   /* set progress bar to 0% and status to init compositing */
   editingtree->progress(editingtree->prh, 0.0);
@@ -88,7 +88,7 @@ void COM_execute(RenderData *rd,
   /* initialize execution system */
   if (twopass) {
     ExecutionSystem *system = new ExecutionSystem(
-        rd, scene, editingtree, rendering, twopass, viewSettings, displaySettings, viewName);
+        rd, scene, editingtree, rendering, twopass, viewSettings, displaySettings, viewName, NULL);
     system->execute();
     delete system;
 
@@ -101,18 +101,46 @@ void COM_execute(RenderData *rd,
   }
 
   ExecutionSystem *system = new ExecutionSystem(
-      rd, scene, editingtree, rendering, false, viewSettings, displaySettings, viewName);
+      rd, scene, editingtree, rendering, false, viewSettings, displaySettings, viewName, NULL);
   system->execute();
   delete system;
 
   BLI_mutex_unlock(&s_compositorMutex);
 }
 
+void COM_execute_frame(RenderData *rd,
+                       Scene *scene,
+                       bNodeTree *editingtree,
+                       Render *re,
+                       const ColorManagedViewSettings *viewSettings,
+                       const ColorManagedDisplaySettings *displaySettings,
+                       const char *viewName)
+{
+  /* Frames are executed at the same time on the CPU, OpenCL devices are shared by
+   * all executions and would only serialize them. */
+  editingtree->flag &= ~NTREE_COM_OPENCL;
+
+  if (editingtree->test_break(editingtree->tbh)) {
+    return;
+  }
+
+  ExecutionSystem *system = new ExecutionSystem(
+      rd, scene, editingtree, true, false, viewSettings, displaySettings, viewName, re);
+  system->execute();
+  delete system;
+}
+
+void COM_clearCaches()
+{
+  BufferCache::clear();
+}
+
 void COM_deinitialize()
 {
   if (is_compositorMutex_init) {
     BLI_mutex_lock(&s_compositorMutex);
     WorkScheduler::deinitialize();
+    BufferCache::clear();
     is_compositorMutex_init = false;
     BLI_mutex_unlock(&s_compositorMutex);
     BLI_mutex_end(&s_compositorMutex);
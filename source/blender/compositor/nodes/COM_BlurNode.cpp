@@ -17,6 +17,8 @@
  */
 
 #include "COM_BlurNode.h"
+#include "BLI_math_base.h"
+#include "COM_ConstantSizeBlurOperation.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_FastGaussianBlurOperation.h"
 #include "COM_GammaCorrectOperation.h"
@@ -48,6 +50,14 @@ void BlurNode::convertToOperations(NodeConverter &converter,
   CompositorQuality quality = context.getQuality();
   NodeOperation *input_operation = NULL, *output_operation = NULL;
 
+  /* Large constant sizes are blurred over the complete image at a cost independent of the
+   * size, relative sizes are only known when executing. */
+  BlurMethod method = COM_BLUR_KERNEL;
+  if (!connectedSizeSocket && !data->relative) {
+    method = BlurEngine::selectMethod(
+        data->filtertype, data->bokeh, size * max_ii(data->sizex, data->sizey));
+  }
+
   if (data->filtertype == R_FILTER_FAST_GAUSS) {
     FastGaussianBlurOperation *operationfgb = new FastGaussianBlurOperation();
     operationfgb->setData(data);
@@ -103,6 +113,19 @@ void BlurNode::convertToOperations(NodeConverter &converter,
     output_operation = operation;
     input_operation = operation;
   }
+  else if (method != COM_BLUR_KERNEL) {
+    ConstantSizeBlurOperation *operation = new ConstantSizeBlurOperation();
+    operation->setData(data);
+    operation->setMethod(method);
+    operation->setSize(size);
+    operation->setExtendBounds(extend_bounds);
+    converter.addOperation(operation);
+
+    converter.mapInputSocket(getInputSocket(1), operation->getInputSocket(1));
+
+    input_operation = operation;
+    output_operation = operation;
+  }
   else if (!data->bokeh) {
     GaussianXBlurOperation *operationx = new GaussianXBlurOperation();
     operationx->setData(data);
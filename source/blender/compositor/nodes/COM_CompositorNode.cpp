@@ -39,6 +39,7 @@ void CompositorNode::convertToOperations(NodeConverter &converter,
   CompositorOperation *compositorOperation = new CompositorOperation();
   compositorOperation->setScene(context.getScene());
   compositorOperation->setSceneName(context.getScene()->id.name);
+  compositorOperation->setRender(context.getRender());
   compositorOperation->setRenderData(context.getRenderData());
   compositorOperation->setViewName(context.getViewName());
   compositorOperation->setbNodeTree(context.getbNodeTree());
@@ -33,6 +33,12 @@ SplitViewerNode::SplitViewerNode(bNode *editorNode) : Node(editorNode)
 void SplitViewerNode::convertToOperations(NodeConverter &converter,
                                           const CompositorContext &context) const
 {
+  if (context.getRender()) {
+    /* Frames composited in parallel each have their own render, they must not all write
+     * to the one viewer image. */
+    return;
+  }
+
   bNode *editorNode = this->getbNode();
   bool do_output = (editorNode->flag & NODE_DO_OUTPUT_RECALC || context.isRendering()) &&
                    (editorNode->flag & NODE_DO_OUTPUT);
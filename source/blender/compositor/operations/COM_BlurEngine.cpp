@@ -0,0 +1,623 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include <string.h>
+
+#include "COM_BlurEngine.h"
+#include "COM_FastGaussianBlurOperation.h"
+
+#include "BLI_math.h"
+#include "BLI_task.h"
+
+#include "DNA_scene_types.h"
+
+#include "MEM_guardedalloc.h"
+
+BlurMethod BlurEngine::selectMethod(int filtertype, bool bokeh, float radius)
+{
+  if (bokeh) {
+    return (radius >= COM_BLUR_FFT_MIN_RADIUS) ? COM_BLUR_FFT : COM_BLUR_KERNEL;
+  }
+
+  switch (filtertype) {
+    case R_FILTER_BOX:
+      if (radius >= COM_BLUR_BOX_MIN_RADIUS) {
+        return COM_BLUR_BOX;
+      }
+      break;
+    case R_FILTER_GAUSS:
+      if (radius >= COM_BLUR_IIR_MIN_RADIUS) {
+        return COM_BLUR_IIR;
+      }
+      break;
+  }
+  return COM_BLUR_KERNEL;
+}
+
+/* ******** Recursive Gaussian ******** */
+
+typedef struct GaussianIIRData {
+  MemoryBuffer *buffer;
+  float sigma_x, sigma_y;
+} GaussianIIRData;
+
+static void gaussian_iir_channel(void *__restrict userdata,
+                                 const int chan,
+                                 const TaskParallelTLS *__restrict /*tls*/)
+{
+  const GaussianIIRData *data = (const GaussianIIRData *)userdata;
+
+  if ((data->sigma_x == data->sigma_y) && (data->sigma_x > 0.0f)) {
+    FastGaussianBlurOperation::IIR_gauss(data->buffer, data->sigma_x, chan, 3);
+    return;
+  }
+  if (data->sigma_x > 0.0f) {
+    FastGaussianBlurOperation::IIR_gauss(data->buffer, data->sigma_x, chan, 1);
+  }
+  if (data->sigma_y > 0.0f) {
+    FastGaussianBlurOperation::IIR_gauss(data->buffer, data->sigma_y, chan, 2);
+  }
+}
+
+void BlurEngine::gaussianIIR(MemoryBuffer *buffer, float sigma_x, float sigma_y)
+{
+  GaussianIIRData data;
+  data.buffer = buffer;
+  data.sigma_x = sigma_x;
+  data.sigma_y = sigma_y;
+
+  /* Channels are filtered independently. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, buffer->get_num_channels(), &data, gaussian_iir_channel, &settings);
+}
+
+/* ******** Box Blur ******** */
+
+/* Columns summed by one task, so the rows read are contiguous. */
+#define BOX_BLUR_COLUMNS 16
+
+typedef struct BoxBlurData {
+  float *buffer;
+  int width, height, num_channels;
+  int radius;
+} BoxBlurData;
+
+/* Average of the pixels within the radius, from the prefix sums of the row. */
+static void box_blur_row(void *__restrict userdata,
+                         const int y,
+                         const TaskParallelTLS *__restrict /*tls*/)
+{
+  const BoxBlurData *data = (const BoxBlurData *)userdata;
+  const int width = data->width;
+  const int num_channels = data->num_channels;
+  float *row = &data->buffer[(size_t)y * width * num_channels];
+  double *sums = (double *)MEM_mallocN(sizeof(double) * (width + 1) * num_channels, __func__);
+
+  for (int c = 0; c < num_channels; c++) {
+    sums[c] = 0.0;
+  }
+  for (int i = 0; i < width * num_channels; i++) {
+    sums[i + num_channels] = sums[i] + row[i];
+  }
+
+  for (int x = 0; x < width; x++) {
+    const int xmin = max_ii(x - data->radius, 0);
+    const int xmax = min_ii(x + data->radius + 1, width);
+    const double fac = 1.0 / (xmax - xmin);
+    for (int c = 0; c < num_channels; c++) {
+      row[x * num_channels + c] = (sums[xmax * num_channels + c] -
+                                   sums[xmin * num_channels + c]) *
+                                  fac;
+    }
+  }
+
+  MEM_freeN(sums);
+}
+
+static void box_blur_columns(void *__restrict userdata,
+                             const int index,
+                             const TaskParallelTLS *__restrict /*tls*/)
+{
+  const BoxBlurData *data = (const BoxBlurData *)userdata;
+  const int width = data->width;
+  const int height = data->height;
+  const int num_channels = data->num_channels;
+  const int x = index * BOX_BLUR_COLUMNS;
+  const int n = (min_ii(x + BOX_BLUR_COLUMNS, width) - x) * num_channels;
+  double *sums = (double *)MEM_mallocN(sizeof(double) * (height + 1) * n, __func__);
+
+  for (int i = 0; i < n; i++) {
+    sums[i] = 0.0;
+  }
+  for (int y = 0; y < height; y++) {
+    const float *src = &data->buffer[((size_t)y * width + x) * num_channels];
+    for (int i = 0; i < n; i++) {
+      sums[(y + 1) * n + i] = sums[y * n + i] + src[i];
+    }
+  }
+
+  for (int y = 0; y < height; y++) {
+    const int ymin = max_ii(y - data->radius, 0);
+    const int ymax = min_ii(y + data->radius + 1, height);
+    const double fac = 1.0 / (ymax - ymin);
+    float *dst = &data->buffer[((size_t)y * width + x) * num_channels];
+    for (int i = 0; i < n; i++) {
+      dst[i] = (sums[ymax * n + i] - sums[ymin * n + i]) * fac;
+    }
+  }
+
+  MEM_freeN(sums);
+}
+
+void BlurEngine::boxBlur(MemoryBuffer *buffer, int radius_x, int radius_y)
+{
+  BoxBlurData data;
+  data.buffer = buffer->getBuffer();
+  data.width = buffer->getWidth();
+  data.height = buffer->getHeight();
+  data.num_channels = buffer->get_num_channels();
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+
+  if (radius_x > 0) {
+    data.radius = radius_x;
+    settings.min_iter_per_thread = 8;
+    BLI_task_parallel_range(0, data.height, &data, box_blur_row, &settings);
+  }
+  if (radius_y > 0) {
+    data.radius = radius_y;
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0,
+                            (data.width + BOX_BLUR_COLUMNS - 1) / BOX_BLUR_COLUMNS,
+                            &data,
+                            box_blur_columns,
+                            &settings);
+  }
+}
+
+/* ******** FFT Convolution ******** */
+
+/*
+ *  2D Fast Hartley Transform, used for convolution
+ */
+
+typedef float fREAL;
+
+// returns next highest power of 2 of x, as well it's log2 in L2
+static unsigned int nextPow2(unsigned int x, unsigned int *L2)
+{
+  unsigned int pw, x_notpow2 = x & (x - 1);
+  *L2 = 0;
+  while (x >>= 1) {
+    ++(*L2);
+  }
+  pw = 1 << (*L2);
+  if (x_notpow2) {
+    (*L2)++;
+    pw <<= 1;
+  }
+  return pw;
+}
+
+//------------------------------------------------------------------------------
+
+// from FXT library by Joerg Arndt, faster in order bitreversal
+// use: r = revbin_upd(r, h) where h = N>>1
+static unsigned int revbin_upd(unsigned int r, unsigned int h)
+{
+  while (!((r ^= h) & h)) {
+    h >>= 1;
+  }
+  return r;
+}
+//------------------------------------------------------------------------------
+static void FHT(fREAL *data, unsigned int M, unsigned int inverse)
+{
+  double tt, fc, dc, fs, ds, a = M_PI;
+  fREAL t1, t2;
+  int n2, bd, bl, istep, k, len = 1 << M, n = 1;
+
+  int i, j = 0;
+  unsigned int Nh = len >> 1;
+  for (i = 1; i < (len - 1); i++) {
+    j = revbin_upd(j, Nh);
+    if (j > i) {
+      t1 = data[i];
+      data[i] = data[j];
+      data[j] = t1;
+    }
+  }
+
+  do {
+    fREAL *data_n = &data[n];
+
+    istep = n << 1;
+    for (k = 0; k < len; k += istep) {
+      t1 = data_n[k];
+      data_n[k] = data[k] - t1;
+      data[k] += t1;
+    }
+
+    n2 = n >> 1;
+    if (n > 2) {
+      fc = dc = cos(a);
+      fs = ds = sqrt(1.0 - fc * fc);  // sin(a);
+      bd = n - 2;
+      for (bl = 1; bl < n2; bl++) {
+        fREAL *data_nbd = &data_n[bd];
+        fREAL *data_bd = &data[bd];
+        for (k = bl; k < len; k += istep) {
+          t1 = fc * (double)data_n[k] + fs * (double)data_nbd[k];
+          t2 = fs * (double)data_n[k] - fc * (double)data_nbd[k];
+          data_n[k] = data[k] - t1;
+          data_nbd[k] = data_bd[k] - t2;
+          data[k] += t1;
+          data_bd[k] += t2;
+        }
+        tt = fc * dc - fs * ds;
+        fs = fs * dc + fc * ds;
+        fc = tt;
+        bd -= 2;
+      }
+    }
+
+    if (n > 1) {
+      for (k = n2; k < len; k += istep) {
+        t1 = data_n[k];
+        data_n[k] = data[k] - t1;
+        data[k] += t1;
+      }
+    }
+
+    n = istep;
+    a *= 0.5;
+  } while (n < len);
+
+  if (inverse) {
+    fREAL sc = (fREAL)1 / (fREAL)len;
+    for (k = 0; k < len; k++) {
+      data[k] *= sc;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+typedef struct FHTRowsData {
+  fREAL *data;
+  unsigned int Nx;
+  unsigned int Mx;
+  unsigned int inverse;
+} FHTRowsData;
+
+static void fht_row(void *__restrict userdata,
+                    const int j,
+                    const TaskParallelTLS *__restrict /*tls*/)
+{
+  FHTRowsData *rows = (FHTRowsData *)userdata;
+  FHT(&rows->data[rows->Nx * j], rows->Mx, rows->inverse);
+}
+
+/* Rows are transformed independently, in parallel. */
+static void FHT_rows(
+    fREAL *data, unsigned int Nx, unsigned int Mx, unsigned int num_rows, unsigned int inverse)
+{
+  FHTRowsData rows;
+  rows.data = data;
+  rows.Nx = Nx;
+  rows.Mx = Mx;
+  rows.inverse = inverse;
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8;
+  BLI_task_parallel_range(0, num_rows, &rows, fht_row, &settings);
+}
+
+/* 2D Fast Hartley Transform, Mx/My -> log2 of width/height,
+ * nzp -> the row where zero pad data starts,
+ * inverse -> see above */
+static void FHT2D(
+    fREAL *data, unsigned int Mx, unsigned int My, unsigned int nzp, unsigned int inverse)
+{
+  unsigned int i, j, Nx, Ny, maxy;
+
+  Nx = 1 << Mx;
+  Ny = 1 << My;
+
+  // rows (forward transform skips 0 pad data)
+  maxy = inverse ? Ny : nzp;
+  FHT_rows(data, Nx, Mx, maxy, inverse);
+
+  // transpose data
+  if (Nx == Ny) {  // square
+    for (j = 0; j < Ny; j++) {
+      for (i = j + 1; i < Nx; i++) {
+        unsigned int op = i + (j << Mx), np = j + (i << My);
+        SWAP(fREAL, data[op], data[np]);
+      }
+    }
+  }
+  else {  // rectangular
+    unsigned int k, Nym = Ny - 1, stm = 1 << (Mx + My);
+    for (i = 0; stm > 0; i++) {
+#define PRED(k) (((k & Nym) << Mx) + (k >> My))
+      for (j = PRED(i); j > i; j = PRED(j)) {
+        /* pass */
+      }
+      if (j < i) {
+        continue;
+      }
+      for (k = i, j = PRED(i); j != i; k = j, j = PRED(j), stm--) {
+        SWAP(fREAL, data[j], data[k]);
+      }
+#undef PRED
+      stm--;
+    }
+  }
+
+  SWAP(unsigned int, Nx, Ny);
+  SWAP(unsigned int, Mx, My);
+
+  // now columns == transposed rows
+  FHT_rows(data, Nx, Mx, Ny, inverse);
+
+  // finalize
+  for (j = 0; j <= (Ny >> 1); j++) {
+    unsigned int jm = (Ny - j) & (Ny - 1);
+    unsigned int ji = j << Mx;
+    unsigned int jmi = jm << Mx;
+    for (i = 0; i <= (Nx >> 1); i++) {
+      unsigned int im = (Nx - i) & (Nx - 1);
+      fREAL A = data[ji + i];
+      fREAL B = data[jmi + i];
+      fREAL C = data[ji + im];
+      fREAL D = data[jmi + im];
+      fREAL E = (fREAL)0.5 * ((A + D) - (B + C));
+      data[ji + i] = A - E;
+      data[jmi + i] = B + E;
+      data[ji + im] = C + E;
+      data[jmi + im] = D - E;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+
+/* 2D convolution calc, d1 *= d2, M/N - > log2 of width/height */
+static void fht_convolve(fREAL *d1, const fREAL *d2, unsigned int M, unsigned int N)
+{
+  fREAL a, b;
+  unsigned int i, j, k, L, mj, mL;
+  unsigned int m = 1 << M, n = 1 << N;
+  unsigned int m2 = 1 << (M - 1), n2 = 1 << (N - 1);
+  unsigned int mn2 = m << (N - 1);
+
+  d1[0] *= d2[0];
+  d1[mn2] *= d2[mn2];
+  d1[m2] *= d2[m2];
+  d1[m2 + mn2] *= d2[m2 + mn2];
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    a = d1[i] * d2[i] - d1[k] * d2[k];
+    b = d1[k] * d2[i] + d1[i] * d2[k];
+    d1[i] = (b + a) * (fREAL)0.5;
+    d1[k] = (b - a) * (fREAL)0.5;
+    a = d1[i + mn2] * d2[i + mn2] - d1[k + mn2] * d2[k + mn2];
+    b = d1[k + mn2] * d2[i + mn2] + d1[i + mn2] * d2[k + mn2];
+    d1[i + mn2] = (b + a) * (fREAL)0.5;
+    d1[k + mn2] = (b - a) * (fREAL)0.5;
+  }
+  for (j = 1; j < n2; j++) {
+    L = n - j;
+    mj = j << M;
+    mL = L << M;
+    a = d1[mj] * d2[mj] - d1[mL] * d2[mL];
+    b = d1[mL] * d2[mj] + d1[mj] * d2[mL];
+    d1[mj] = (b + a) * (fREAL)0.5;
+    d1[mL] = (b - a) * (fREAL)0.5;
+    a = d1[m2 + mj] * d2[m2 + mj] - d1[m2 + mL] * d2[m2 + mL];
+    b = d1[m2 + mL] * d2[m2 + mj] + d1[m2 + mj] * d2[m2 + mL];
+    d1[m2 + mj] = (b + a) * (fREAL)0.5;
+    d1[m2 + mL] = (b - a) * (fREAL)0.5;
+  }
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    for (j = 1; j < n2; j++) {
+      L = n - j;
+      mj = j << M;
+      mL = L << M;
+      a = d1[i + mj] * d2[i + mj] - d1[k + mL] * d2[k + mL];
+      b = d1[k + mL] * d2[i + mj] + d1[i + mj] * d2[k + mL];
+      d1[i + mj] = (b + a) * (fREAL)0.5;
+      d1[k + mL] = (b - a) * (fREAL)0.5;
+      a = d1[i + mL] * d2[i + mL] - d1[k + mj] * d2[k + mj];
+      b = d1[k + mj] * d2[i + mL] + d1[i + mL] * d2[k + mj];
+      d1[i + mL] = (b + a) * (fREAL)0.5;
+      d1[k + mj] = (b - a) * (fREAL)0.5;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+
+typedef struct ConvolveData {
+  /* Transformed kernel. */
+  const fREAL *data1;
+  const float *image;
+  float *dst;
+  int width, height, image_channels, num_channels;
+  unsigned int w2, h2, log2_w, log2_h;
+  int hw, hh;
+  int xbsz, ybsz, nxb;
+  /* Row of blocks of the first task. */
+  int ybl_start;
+} ConvolveData;
+
+/* Convolve one channel of a row of blocks, blocks in the same row overlap so they are added one
+ * after the other. Rows of blocks only overlap with their direct neighbors. */
+static void convolve_block_row(void *__restrict userdata,
+                               const int index,
+                               const TaskParallelTLS *__restrict /*tls*/)
+{
+  const ConvolveData *cd = (const ConvolveData *)userdata;
+  const int ybl = cd->ybl_start + 2 * (index / cd->num_channels);
+  const int ch = index % cd->num_channels;
+  const int stride = cd->image_channels;
+  const unsigned int w2 = cd->w2, h2 = cd->h2;
+  fREAL *data2 = (fREAL *)MEM_mallocN(w2 * h2 * sizeof(fREAL), "convolve_fast FHT data2");
+  fREAL *fp;
+  int x, y;
+
+  for (int xbl = 0; xbl < cd->nxb; xbl++) {
+    // image, channel ch -> data2
+    memset(data2, 0, w2 * h2 * sizeof(fREAL));
+    for (y = 0; y < cd->ybsz; y++) {
+      int yy = ybl * cd->ybsz + y;
+      if (yy >= cd->height) {
+        continue;
+      }
+      fp = &data2[y * w2];
+      const float *row = &cd->image[(size_t)yy * cd->width * stride + ch];
+      for (x = 0; x < cd->xbsz; x++) {
+        int xx = xbl * cd->xbsz + x;
+        if (xx >= cd->width) {
+          continue;
+        }
+        fp[x] = row[xx * stride];
+      }
+    }
+
+    // forward FHT
+    // zero pad data starts after the rows of the block
+    FHT2D(data2, cd->log2_w, cd->log2_h, cd->ybsz, 0);
+
+    // FHT2D transposed data, row/col now swapped
+    // convolve & inverse FHT
+    fht_convolve(data2, cd->data1, cd->log2_h, cd->log2_w);
+    FHT2D(data2, cd->log2_h, cd->log2_w, 0, 1);
+    // data again transposed, so in order again
+
+    // overlap-add result
+    for (y = 0; y < (int)h2; y++) {
+      const int yy = ybl * cd->ybsz + y - cd->hh;
+      if ((yy < 0) || (yy >= cd->height)) {
+        continue;
+      }
+      fp = &data2[y * w2];
+      float *row = &cd->dst[(size_t)yy * cd->width * stride + ch];
+      for (x = 0; x < (int)w2; x++) {
+        const int xx = xbl * cd->xbsz + x - cd->hw;
+        if ((xx < 0) || (xx >= cd->width)) {
+          continue;
+        }
+        row[xx * stride] += fp[x];
+      }
+    }
+  }
+
+  MEM_freeN(data2);
+}
+
+void BlurEngine::convolveFFT(float *dst,
+                             const float *image,
+                             int width,
+                             int height,
+                             int image_channels,
+                             int num_channels,
+                             const float *kernel,
+                             int kernel_width,
+                             int kernel_height)
+{
+  fREAL *data1;
+  unsigned int w2, h2, log2_w, log2_h;
+  int x, y, nxb, nyb, xbsz, ybsz;
+
+  memset(dst, 0, sizeof(float) * width * height * image_channels);
+
+  // convolution result width & height
+  w2 = 2 * kernel_width - 1;
+  h2 = 2 * kernel_height - 1;
+  // FFT pow2 required size & log2
+  w2 = nextPow2(w2, &log2_w);
+  h2 = nextPow2(h2, &log2_h);
+
+  // alloc space
+  data1 = (fREAL *)MEM_callocN(w2 * h2 * sizeof(fREAL), "convolve_fast FHT data1");
+
+  // normalize convolutor
+  float wt = 0.0f;
+  for (y = 0; y < kernel_width * kernel_height; y++) {
+    wt += kernel[y];
+  }
+  if (wt != 0.0f) {
+    wt = 1.0f / wt;
+  }
+
+  // only need to calc fht data of the kernel once, can re-use for every block and channel
+  for (y = 0; y < kernel_height; y++) {
+    fREAL *fp = &data1[y * w2];
+    const float *kp = &kernel[y * kernel_width];
+    for (x = 0; x < kernel_width; x++) {
+      fp[x] = kp[x] * wt;
+    }
+  }
+  FHT2D(data1, log2_w, log2_h, kernel_height + 1, 0);
+
+  // block add-overlap
+  xbsz = (w2 + 1) - kernel_width;
+  ybsz = (h2 + 1) - kernel_height;
+  nxb = width / xbsz;
+  if (width % xbsz) {
+    nxb++;
+  }
+  nyb = height / ybsz;
+  if (height % ybsz) {
+    nyb++;
+  }
+
+  ConvolveData cd;
+  cd.data1 = data1;
+  cd.image = image;
+  cd.dst = dst;
+  cd.width = width;
+  cd.height = height;
+  cd.image_channels = image_channels;
+  cd.num_channels = num_channels;
+  cd.w2 = w2;
+  cd.h2 = h2;
+  cd.log2_w = log2_w;
+  cd.log2_h = log2_h;
+  cd.hw = kernel_width >> 1;
+  cd.hh = kernel_height >> 1;
+  cd.xbsz = xbsz;
+  cd.ybsz = ybsz;
+  cd.nxb = nxb;
+
+  // each channel of every other row of blocks in parallel, the even rows first
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  for (cd.ybl_start = 0; cd.ybl_start < 2; cd.ybl_start++) {
+    const int num_rows = (nyb - cd.ybl_start + 1) / 2;
+    BLI_task_parallel_range(0, num_rows * num_channels, &cd, convolve_block_row, &settings);
+  }
+
+  MEM_freeN(data1);
+}
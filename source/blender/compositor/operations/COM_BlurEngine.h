@@ -0,0 +1,80 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#pragma once
+
+#include "COM_MemoryBuffer.h"
+
+/* Below these radii in pixels the direct kernels are faster than the engine. */
+#define COM_BLUR_BOX_MIN_RADIUS 8
+#define COM_BLUR_IIR_MIN_RADIUS 24
+#define COM_BLUR_FFT_MIN_RADIUS 16
+
+typedef enum BlurMethod {
+  /** Convolve with the filter kernel directly, cost proportional to the radius. */
+  COM_BLUR_KERNEL = 0,
+  /** Recursive Gaussian (Young/van Vliet), cost independent of the radius. */
+  COM_BLUR_IIR = 1,
+  /** Box filter from running sums over the rows and columns. */
+  COM_BLUR_BOX = 2,
+  /** Convolve with a 2D kernel using the Fast Hartley Transform. */
+  COM_BLUR_FFT = 3,
+} BlurMethod;
+
+/**
+ * \brief Blur algorithms working on complete buffers, with a cost that does not grow
+ * (or only logarithmically) with the radius.
+ */
+class BlurEngine {
+ public:
+  /**
+   * \brief Pick the fastest method giving the same result as the kernel of the filter.
+   * \param radius: blur radius in pixels, the largest of both axes
+   * \param bokeh: use a circular 2D kernel instead of two separable passes
+   */
+  static BlurMethod selectMethod(int filtertype, bool bokeh, float radius);
+
+  /**
+   * \brief Gaussian blur of all channels, sigma in pixels along each axis.
+   */
+  static void gaussianIIR(MemoryBuffer *buffer, float sigma_x, float sigma_y);
+
+  /**
+   * \brief Box blur of all channels, averaging `2 * radius + 1` pixels along each axis.
+   * Pixels outside of the buffer are left out of the average.
+   */
+  static void boxBlur(MemoryBuffer *buffer, int radius_x, int radius_y);
+
+  /**
+   * \brief Convolve the first num_channels channels of the image with a single channel kernel.
+   *
+   * The kernel is normalized and centered at its half width and height, pixels outside of
+   * the image count as zero. Other channels of dst are cleared.
+   *
+   * \param dst: buffer of the size of the image with the same number of channels
+   */
+  static void convolveFFT(float *dst,
+                          const float *image,
+                          int width,
+                          int height,
+                          int image_channels,
+                          int num_channels,
+                          const float *kernel,
+                          int kernel_width,
+                          int kernel_height);
+};
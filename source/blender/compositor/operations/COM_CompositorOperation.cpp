@@ -50,9 +50,18 @@ CompositorOperation::CompositorOperation() : NodeOperation()
 
   this->m_scene = NULL;
   this->m_sceneName[0] = '\0';
+  this->m_render = NULL;
   this->m_viewName = NULL;
 }
 
+Render *CompositorOperation::getRender() const
+{
+  if (this->m_render) {
+    return this->m_render;
+  }
+  return RE_GetSceneRender(this->m_scene);
+}
+
 void CompositorOperation::initExecution()
 {
   if (!this->m_active) {
@@ -80,7 +89,7 @@ void CompositorOperation::deinitExecution()
   }
 
   if (!isBraked()) {
-    Render *re = RE_GetSceneRender(this->m_scene);
+    Render *re = getRender();
     RenderResult *rr = RE_AcquireResultWrite(re);
 
     if (rr) {
@@ -110,12 +119,15 @@ void CompositorOperation::deinitExecution()
       re = NULL;
     }
 
-    BLI_thread_lock(LOCK_DRAW_IMAGE);
-    BKE_image_signal(G.main,
-                     BKE_image_ensure_viewer(G.main, IMA_TYPE_R_RESULT, "Render Result"),
-                     NULL,
-                     IMA_SIGNAL_FREE);
-    BLI_thread_unlock(LOCK_DRAW_IMAGE);
+    /* A render of its own is not displayed in the render result image. */
+    if (this->m_render == NULL) {
+      BLI_thread_lock(LOCK_DRAW_IMAGE);
+      BKE_image_signal(G.main,
+                       BKE_image_ensure_viewer(G.main, IMA_TYPE_R_RESULT, "Render Result"),
+                       NULL,
+                       IMA_SIGNAL_FREE);
+      BLI_thread_unlock(LOCK_DRAW_IMAGE);
+    }
   }
   else {
     if (this->m_outputBuffer) {
@@ -225,7 +237,7 @@ void CompositorOperation::determineResolution(unsigned int resolution[2],
 
   // check actual render resolution with cropping it may differ with cropped border.rendering
   // FIX for: [31777] Border Crop gives black (easy)
-  Render *re = RE_GetSceneRender(this->m_scene);
+  Render *re = getRender();
   if (re) {
     RenderResult *rr = RE_AcquireResultRead(re);
     if (rr) {
@@ -22,6 +22,7 @@
 #include "BLI_string.h"
 #include "COM_NodeOperation.h"
 
+struct Render;
 struct Scene;
 
 /**
@@ -35,6 +36,11 @@ class CompositorOperation : public NodeOperation {
    */
   char m_sceneName[MAX_ID_NAME];
 
+  /**
+   * \brief Render receiving the result, when NULL the render of the scene is used.
+   */
+  struct Render *m_render;
+
   /**
    * \brief local reference to the scene
    */
@@ -80,6 +86,8 @@ class CompositorOperation : public NodeOperation {
    */
   const char *m_viewName;
 
+  struct Render *getRender() const;
+
  public:
   CompositorOperation();
   bool isActiveCompositorOutput() const
@@ -95,6 +103,10 @@ class CompositorOperation : public NodeOperation {
   {
     BLI_strncpy(this->m_sceneName, sceneName, sizeof(this->m_sceneName));
   }
+  void setRender(struct Render *render)
+  {
+    this->m_render = render;
+  }
   void setViewName(const char *viewName)
   {
     this->m_viewName = viewName;
@@ -0,0 +1,170 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#include "COM_ConstantSizeBlurOperation.h"
+#include "BLI_math.h"
+#include "MEM_guardedalloc.h"
+
+#include "RE_pipeline.h"
+
+ConstantSizeBlurOperation::ConstantSizeBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
+{
+  this->m_method = COM_BLUR_IIR;
+  this->m_result = NULL;
+}
+
+void ConstantSizeBlurOperation::executePixel(float output[4], int x, int y, void *data)
+{
+  MemoryBuffer *result = (MemoryBuffer *)data;
+  result->read(output, x, y);
+}
+
+bool ConstantSizeBlurOperation::determineDependingAreaOfInterest(
+    rcti * /*input*/, ReadBufferOperation *readOperation, rcti *output)
+{
+  rcti newInput;
+
+  if (this->m_result) {
+    return false;
+  }
+
+  newInput.xmin = 0;
+  newInput.ymin = 0;
+  newInput.xmax = this->getWidth();
+  newInput.ymax = this->getHeight();
+
+  return NodeOperation::determineDependingAreaOfInterest(&newInput, readOperation, output);
+}
+
+void ConstantSizeBlurOperation::initExecution()
+{
+  BlurBaseOperation::initExecution();
+  initMutex();
+}
+
+void ConstantSizeBlurOperation::deinitExecution()
+{
+  if (this->m_result) {
+    delete this->m_result;
+    this->m_result = NULL;
+  }
+  BlurBaseOperation::deinitExecution();
+  deinitMutex();
+}
+
+/* Same kernel as GaussianBokehBlurOperation, the weights of pixels outside of the image are
+ * left out by dividing by the convolution of the image area. */
+void ConstantSizeBlurOperation::blurBokehFFT(MemoryBuffer *result,
+                                             MemoryBuffer *input,
+                                             float radxf,
+                                             float radyf)
+{
+  const int width = input->getWidth();
+  const int height = input->getHeight();
+  const int radx = ceil(radxf);
+  const int rady = ceil(radyf);
+  const int kernel_width = 2 * radx + 1;
+  const int kernel_height = 2 * rady + 1;
+  const float facx = (radxf > 0.0f ? 1.0f / radxf : 0.0f);
+  const float facy = (radyf > 0.0f ? 1.0f / radyf : 0.0f);
+
+  float *kernel = (float *)MEM_mallocN(sizeof(float) * kernel_width * kernel_height, __func__);
+  float *dkernel = kernel;
+  float sum = 0.0f;
+  for (int j = -rady; j <= rady; j++) {
+    for (int i = -radx; i <= radx; i++, dkernel++) {
+      float fj = (float)j * facy;
+      float fi = (float)i * facx;
+      *dkernel = RE_filter_value(this->m_data.filtertype, sqrtf(fj * fj + fi * fi));
+      sum += *dkernel;
+    }
+  }
+  if (sum == 0.0f) {
+    kernel[rady * kernel_width + radx] = 1.0f;
+  }
+
+  BlurEngine::convolveFFT(result->getBuffer(),
+                          input->getBuffer(),
+                          width,
+                          height,
+                          COM_NUM_CHANNELS_COLOR,
+                          COM_NUM_CHANNELS_COLOR,
+                          kernel,
+                          kernel_width,
+                          kernel_height);
+
+  float *area = (float *)MEM_mallocN(sizeof(float) * width * height, __func__);
+  float *weights = (float *)MEM_mallocN(sizeof(float) * width * height, __func__);
+  for (int i = 0; i < width * height; i++) {
+    area[i] = 1.0f;
+  }
+  BlurEngine::convolveFFT(
+      weights, area, width, height, 1, 1, kernel, kernel_width, kernel_height);
+
+  float *buffer = result->getBuffer();
+  for (int i = 0; i < width * height; i++, buffer += COM_NUM_CHANNELS_COLOR) {
+    if (weights[i] > 0.0f) {
+      mul_v4_fl(buffer, 1.0f / weights[i]);
+    }
+  }
+
+  MEM_freeN(weights);
+  MEM_freeN(area);
+  MEM_freeN(kernel);
+}
+
+void *ConstantSizeBlurOperation::initializeTileData(rcti *rect)
+{
+  lockMutex();
+  if (!this->m_result) {
+    MemoryBuffer *input = (MemoryBuffer *)this->m_inputProgram->initializeTileData(rect);
+    updateSize();
+
+    const float radxf = max_ff(this->m_size * this->m_data.sizex, 0.0f);
+    const float radyf = max_ff(this->m_size * this->m_data.sizey, 0.0f);
+
+    switch (this->m_method) {
+      case COM_BLUR_FFT: {
+        MemoryBuffer *result = new MemoryBuffer(COM_DT_COLOR, input->getRect());
+        blurBokehFFT(result,
+                     input,
+                     min_ff(radxf, this->getWidth() / 2.0f),
+                     min_ff(radyf, this->getHeight() / 2.0f));
+        this->m_result = result;
+        break;
+      }
+      case COM_BLUR_BOX: {
+        /* Pixels within the radius have a weight of one. */
+        MemoryBuffer *result = input->duplicate();
+        BlurEngine::boxBlur(result, (int)radxf, (int)radyf);
+        this->m_result = result;
+        break;
+      }
+      case COM_BLUR_IIR:
+      default: {
+        /* The Gaussian filter reaches zero at three sigma. */
+        MemoryBuffer *result = input->duplicate();
+        BlurEngine::gaussianIIR(result, radxf / 3.0f, radyf / 3.0f);
+        this->m_result = result;
+        break;
+      }
+    }
+  }
+  unlockMutex();
+  return this->m_result;
+}
@@ -0,0 +1,51 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2020, Blender Foundation.
+ */
+
+#pragma once
+
+#include "COM_BlurBaseOperation.h"
+#include "COM_BlurEngine.h"
+
+/**
+ * \brief Blur with a size that is known when converting the node tree, calculated over the
+ * complete image by the BlurEngine so large radii are not slower than small ones.
+ * \see BlurEngine.selectMethod
+ */
+class ConstantSizeBlurOperation : public BlurBaseOperation {
+ private:
+  BlurMethod m_method;
+  MemoryBuffer *m_result;
+
+  void blurBokehFFT(MemoryBuffer *result, MemoryBuffer *input, float radxf, float radyf);
+
+ public:
+  ConstantSizeBlurOperation();
+  bool determineDependingAreaOfInterest(rcti *input,
+                                        ReadBufferOperation *readOperation,
+                                        rcti *output);
+  void executePixel(float output[4], int x, int y, void *data);
+
+  void *initializeTileData(rcti *rect);
+  void initExecution();
+  void deinitExecution();
+
+  void setMethod(BlurMethod method)
+  {
+    this->m_method = method;
+  }
+};
@@ -54,6 +54,18 @@ void ConvertValueToColorOperation::executePixelSampled(float output[4],
   output[3] = 1.0f;
 }
 
+void ConvertValueToColorOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  float values[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  this->m_inputOperation->readSpanSampled(values, x, y, width);
+  for (int i = 0; i < width; i++) {
+    const float value = values[i * COM_NUM_CHANNELS_COLOR];
+    float *color = &output[i * COM_NUM_CHANNELS_COLOR];
+    color[0] = color[1] = color[2] = value;
+    color[3] = 1.0f;
+  }
+}
+
 /* ******** Color to Value ******** */
 
 ConvertColorToValueOperation::ConvertColorToValueOperation() : ConvertBaseOperation()
@@ -72,6 +84,16 @@ void ConvertColorToValueOperation::executePixelSampled(float output[4],
   output[0] = (inputColor[0] + inputColor[1] + inputColor[2]) / 3.0f;
 }
 
+void ConvertColorToValueOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  float colors[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  this->m_inputOperation->readSpanSampled(colors, x, y, width);
+  for (int i = 0; i < width; i++) {
+    const float *color = &colors[i * COM_NUM_CHANNELS_COLOR];
+    output[i * COM_NUM_CHANNELS_COLOR] = (color[0] + color[1] + color[2]) / 3.0f;
+  }
+}
+
 /* ******** Color to BW ******** */
 
 ConvertColorToBWOperation::ConvertColorToBWOperation() : ConvertBaseOperation()
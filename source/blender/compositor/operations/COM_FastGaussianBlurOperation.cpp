@@ -19,6 +19,7 @@
 #include <limits.h>
 
 #include "BLI_utildefines.h"
+#include "COM_BlurEngine.h"
 #include "COM_FastGaussianBlurOperation.h"
 #include "MEM_guardedalloc.h"
 
@@ -83,27 +84,10 @@ void *FastGaussianBlurOperation::initializeTileData(rcti *rect)
     MemoryBuffer *copy = newBuf->duplicate();
     updateSize();
 
-    int c;
     this->m_sx = this->m_data.sizex * this->m_size / 2.0f;
     this->m_sy = this->m_data.sizey * this->m_size / 2.0f;
 
-    if ((this->m_sx == this->m_sy) && (this->m_sx > 0.0f)) {
-      for (c = 0; c < COM_NUM_CHANNELS_COLOR; c++) {
-        IIR_gauss(copy, this->m_sx, c, 3);
-      }
-    }
-    else {
-      if (this->m_sx > 0.0f) {
-        for (c = 0; c < COM_NUM_CHANNELS_COLOR; c++) {
-          IIR_gauss(copy, this->m_sx, c, 1);
-        }
-      }
-      if (this->m_sy > 0.0f) {
-        for (c = 0; c < COM_NUM_CHANNELS_COLOR; c++) {
-          IIR_gauss(copy, this->m_sy, c, 2);
-        }
-      }
-    }
+    BlurEngine::gaussianIIR(copy, this->m_sx, this->m_sy);
     this->m_iirgaus = copy;
   }
   unlockMutex();
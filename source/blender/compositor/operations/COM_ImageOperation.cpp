@@ -18,6 +18,8 @@
 
 #include "COM_ImageOperation.h"
 
+#include "COM_BufferCache.h"
+
 #include "BKE_image.h"
 #include "BKE_scene.h"
 #include "BLI_listbase.h"
@@ -102,6 +104,34 @@ void BaseImageOperation::deinitExecution()
   BKE_image_release_ibuf(this->m_image, this->m_buffer, NULL);
 }
 
+bool BaseImageOperation::hashExternalData(CacheHash *hash)
+{
+  ImBuf *ibuf = this->m_buffer;
+  if (ibuf == NULL) {
+    hash->addInt(0);
+    return true;
+  }
+  const size_t num_pixels = (size_t)ibuf->x * ibuf->y;
+  hash->addInt(ibuf->x);
+  hash->addInt(ibuf->y);
+  hash->addInt(ibuf->channels);
+  if (ibuf->rect_float) {
+    hash->add(ibuf->rect_float, sizeof(float) * num_pixels * ibuf->channels);
+    hash->add(&ibuf->float_colorspace, sizeof(ibuf->float_colorspace));
+  }
+  else if (ibuf->rect) {
+    hash->add(ibuf->rect, sizeof(unsigned int) * num_pixels);
+    hash->add(&ibuf->rect_colorspace, sizeof(ibuf->rect_colorspace));
+  }
+  if (ibuf->zbuf_float) {
+    hash->add(ibuf->zbuf_float, sizeof(float) * num_pixels);
+  }
+  if (this->m_image) {
+    hash->addInt(this->m_image->alpha_mode);
+  }
+  return true;
+}
+
 void BaseImageOperation::determineResolution(unsigned int resolution[2],
                                              unsigned int /*preferredResolution*/[2])
 {
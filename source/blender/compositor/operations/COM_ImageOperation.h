@@ -57,6 +57,7 @@ class BaseImageOperation : public NodeOperation {
  public:
   void initExecution();
   void deinitExecution();
+  bool hashExternalData(CacheHash *hash);
   void setImage(Image *image)
   {
     this->m_image = image;
@@ -88,24 +88,57 @@ int InpaintSimpleOperation::mdist(int x, int y)
   return this->m_manhattan_distance[y * width + x];
 }
 
-bool InpaintSimpleOperation::next_pixel(int &x, int &y, int &curr, int iters)
+typedef struct ManhattanDistanceData {
+  const float *buffer;
+  short *distance;
+  int width;
+  int height;
+} ManhattanDistanceData;
+
+/* The manhattan distance transform is separable, first find the distance to the nearest known
+ * pixel in the same row, then the nearest of these in the same column. */
+static void manhattan_distance_row(void *__restrict userdata,
+                                   const int y,
+                                   const TaskParallelTLS *__restrict /*tls*/)
 {
-  int width = this->getWidth();
-
-  if (curr >= this->m_area_size) {
-    return false;
+  ManhattanDistanceData *data = (ManhattanDistanceData *)userdata;
+  const int width = data->width;
+  const int max_distance = data->width + data->height;
+  const float *pixel = &data->buffer[y * width * COM_NUM_CHANNELS_COLOR];
+  short *m = &data->distance[y * width];
+
+  int r = max_distance;
+  for (int x = 0; x < width; x++) {
+    r = (pixel[x * COM_NUM_CHANNELS_COLOR + 3] < 1.0f) ? min_ii(r + 1, max_distance) : 0;
+    m[x] = r;
   }
-
-  int r = this->m_pixelorder[curr++];
-
-  x = r % width;
-  y = r / width;
-
-  if (this->mdist(x, y) > iters) {
-    return false;
+  r = max_distance;
+  for (int x = width - 1; x >= 0; x--) {
+    r = min_ii(r + 1, m[x]);
+    m[x] = r;
   }
+}
 
-  return true;
+static void manhattan_distance_column(void *__restrict userdata,
+                                      const int x,
+                                      const TaskParallelTLS *__restrict /*tls*/)
+{
+  ManhattanDistanceData *data = (ManhattanDistanceData *)userdata;
+  const int width = data->width;
+  const int height = data->height;
+  const int max_distance = data->width + data->height;
+  short *m = &data->distance[x];
+
+  int r = max_distance;
+  for (int y = 0; y < height; y++) {
+    r = min_ii(r + 1, m[y * width]);
+    m[y * width] = r;
+  }
+  r = max_distance;
+  for (int y = height - 1; y >= 0; y--) {
+    r = min_ii(r + 1, m[y * width]);
+    m[y * width] = r;
+  }
 }
 
 void InpaintSimpleOperation::calc_manhattan_distance()
@@ -119,38 +152,20 @@ void InpaintSimpleOperation::calc_manhattan_distance()
   offsets = (int *)MEM_callocN(sizeof(int) * (width + height + 1),
                                "InpaintSimpleOperation offsets");
 
-  for (int j = 0; j < height; j++) {
-    for (int i = 0; i < width; i++) {
-      int r = 0;
-      /* no need to clamp here */
-      if (this->get_pixel(i, j)[3] < 1.0f) {
-        r = width + height;
-        if (i > 0) {
-          r = min_ii(r, m[j * width + i - 1] + 1);
-        }
-        if (j > 0) {
-          r = min_ii(r, m[(j - 1) * width + i] + 1);
-        }
-      }
-      m[j * width + i] = r;
-    }
-  }
-
-  for (int j = height - 1; j >= 0; j--) {
-    for (int i = width - 1; i >= 0; i--) {
-      int r = m[j * width + i];
+  ManhattanDistanceData data;
+  data.buffer = this->m_cached_buffer;
+  data.distance = m;
+  data.width = width;
+  data.height = height;
 
-      if (i + 1 < width) {
-        r = min_ii(r, m[j * width + i + 1] + 1);
-      }
-      if (j + 1 < height) {
-        r = min_ii(r, m[(j + 1) * width + i] + 1);
-      }
-
-      m[j * width + i] = r;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 16;
+  BLI_task_parallel_range(0, height, &data, manhattan_distance_row, &settings);
+  BLI_task_parallel_range(0, width, &data, manhattan_distance_column, &settings);
 
-      offsets[r]++;
-    }
+  for (int i = 0; i < width * height; i++) {
+    offsets[m[i]]++;
   }
 
   offsets[0] = 0;
@@ -213,6 +228,16 @@ void InpaintSimpleOperation::pix_step(int x, int y)
   }
 }
 
+void InpaintSimpleOperation::pix_step_task(void *__restrict userdata,
+                                           const int index,
+                                           const TaskParallelTLS *__restrict /*tls*/)
+{
+  InpaintSimpleOperation *operation = (InpaintSimpleOperation *)userdata;
+  const int width = operation->getWidth();
+  const int r = operation->m_pixelorder[index];
+  operation->pix_step(r % width, r / width);
+}
+
 void *InpaintSimpleOperation::initializeTileData(rcti *rect)
 {
   if (this->m_cached_buffer_ready) {
@@ -225,11 +250,26 @@ void *InpaintSimpleOperation::initializeTileData(rcti *rect)
 
     this->calc_manhattan_distance();
 
-    int curr = 0;
-    int x, y;
-
-    while (this->next_pixel(x, y, curr, this->m_iterations)) {
-      this->pix_step(x, y);
+    /* Pixels are only filled from neighbors closer to the known pixels,
+     * so all pixels at the same distance can be filled in parallel. */
+    const int width = this->getWidth();
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 256;
+
+    int start = 0;
+    while (start < this->m_area_size) {
+      const int r = this->m_pixelorder[start];
+      const int d = this->mdist(r % width, r / width);
+      if (d > this->m_iterations) {
+        break;
+      }
+      int end = start + 1;
+      while (end < this->m_area_size && this->m_manhattan_distance[this->m_pixelorder[end]] == d) {
+        end++;
+      }
+      BLI_task_parallel_range(start, end, this, pix_step_task, &settings);
+      start = end;
     }
     this->m_cached_buffer_ready = true;
   }
@@ -20,6 +20,8 @@
 
 #include "COM_NodeOperation.h"
 
+#include "BLI_task.h"
+
 class InpaintSimpleOperation : public NodeOperation {
  protected:
   /**
@@ -69,6 +71,8 @@ class InpaintSimpleOperation : public NodeOperation {
   void clamp_xy(int &x, int &y);
   float *get_pixel(int x, int y);
   int mdist(int x, int y);
-  bool next_pixel(int &x, int &y, int &curr, int iters);
   void pix_step(int x, int y);
+  static void pix_step_task(void *__restrict userdata,
+                            const int index,
+                            const TaskParallelTLS *__restrict tls);
 };
@@ -95,6 +95,29 @@ void MixBaseOperation::deinitExecution()
   this->m_inputColor2Operation = NULL;
 }
 
+void MixBaseOperation::readInputSpans(
+    float *value, float *color1, float *color2, int x, int y, int width)
+{
+  this->m_inputValueOperation->readSpanSampled(value, x, y, width);
+  this->m_inputColor1Operation->readSpanSampled(color1, x, y, width);
+  this->m_inputColor2Operation->readSpanSampled(color2, x, y, width);
+}
+
+void MixBaseOperation::spanMixFactors(float *factors,
+                                      const float *value,
+                                      const float *color2,
+                                      int width)
+{
+  for (int i = 0; i < width; i++) {
+    factors[i] = value[i * COM_NUM_CHANNELS_COLOR];
+  }
+  if (this->useValueAlphaMultiply()) {
+    for (int i = 0; i < width; i++) {
+      factors[i] *= color2[i * COM_NUM_CHANNELS_COLOR + 3];
+    }
+  }
+}
+
 /* ******** Mix Add Operation ******** */
 
 MixAddOperation::MixAddOperation() : MixBaseOperation()
@@ -124,6 +147,30 @@ void MixAddOperation::executePixelSampled(float output[4], float x, float y, Pix
   clampIfNeeded(output);
 }
 
+void MixAddOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  float value[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color1[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color2[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float factors[COM_SPAN_MAX_WIDTH];
+
+  readInputSpans(value, color1, color2, x, y, width);
+  spanMixFactors(factors, value, color2, width);
+
+  for (int i = 0; i < width; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *result = &output[i * COM_NUM_CHANNELS_COLOR];
+    const float factor = factors[i];
+    result[0] = inputColor1[0] + factor * inputColor2[0];
+    result[1] = inputColor1[1] + factor * inputColor2[1];
+    result[2] = inputColor1[2] + factor * inputColor2[2];
+    result[3] = inputColor1[3];
+
+    clampIfNeeded(result);
+  }
+}
+
 /* ******** Mix Blend Operation ******** */
 
 MixBlendOperation::MixBlendOperation() : MixBaseOperation()
@@ -158,6 +205,31 @@ void MixBlendOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixBlendOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  float value[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color1[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color2[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float factors[COM_SPAN_MAX_WIDTH];
+
+  readInputSpans(value, color1, color2, x, y, width);
+  spanMixFactors(factors, value, color2, width);
+
+  for (int i = 0; i < width; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *result = &output[i * COM_NUM_CHANNELS_COLOR];
+    const float factor = factors[i];
+    const float factorm = 1.0f - factor;
+    result[0] = factorm * inputColor1[0] + factor * inputColor2[0];
+    result[1] = factorm * inputColor1[1] + factor * inputColor2[1];
+    result[2] = factorm * inputColor1[2] + factor * inputColor2[2];
+    result[3] = inputColor1[3];
+
+    clampIfNeeded(result);
+  }
+}
+
 /* ******** Mix Burn Operation ******** */
 
 MixColorBurnOperation::MixColorBurnOperation() : MixBaseOperation()
@@ -705,6 +777,31 @@ void MixMultiplyOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixMultiplyOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  float value[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color1[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color2[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float factors[COM_SPAN_MAX_WIDTH];
+
+  readInputSpans(value, color1, color2, x, y, width);
+  spanMixFactors(factors, value, color2, width);
+
+  for (int i = 0; i < width; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *result = &output[i * COM_NUM_CHANNELS_COLOR];
+    const float factor = factors[i];
+    const float factorm = 1.0f - factor;
+    result[0] = inputColor1[0] * (factorm + factor * inputColor2[0]);
+    result[1] = inputColor1[1] * (factorm + factor * inputColor2[1]);
+    result[2] = inputColor1[2] * (factorm + factor * inputColor2[2]);
+    result[3] = inputColor1[3];
+
+    clampIfNeeded(result);
+  }
+}
+
 /* ******** Mix Ovelray Operation ******** */
 
 MixOverlayOperation::MixOverlayOperation() : MixBaseOperation()
@@ -909,6 +1006,30 @@ void MixSubtractOperation::executePixelSampled(float output[4],
   clampIfNeeded(output);
 }
 
+void MixSubtractOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  float value[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color1[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float color2[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  float factors[COM_SPAN_MAX_WIDTH];
+
+  readInputSpans(value, color1, color2, x, y, width);
+  spanMixFactors(factors, value, color2, width);
+
+  for (int i = 0; i < width; i++) {
+    const float *inputColor1 = &color1[i * COM_NUM_CHANNELS_COLOR];
+    const float *inputColor2 = &color2[i * COM_NUM_CHANNELS_COLOR];
+    float *result = &output[i * COM_NUM_CHANNELS_COLOR];
+    const float factor = factors[i];
+    result[0] = inputColor1[0] - factor * inputColor2[0];
+    result[1] = inputColor1[1] - factor * inputColor2[1];
+    result[2] = inputColor1[2] - factor * inputColor2[2];
+    result[3] = inputColor1[3];
+
+    clampIfNeeded(result);
+  }
+}
+
 /* ******** Mix Value Operation ******** */
 
 MixValueOperation::MixValueOperation() : MixBaseOperation()
@@ -43,6 +43,18 @@ class MixBaseOperation : public NodeOperation {
     }
   }
 
+  /**
+   * Read a span of all inputs, for programs that mix whole spans at once.
+   * Every span holds width * COM_NUM_CHANNELS_COLOR floats.
+   */
+  void readInputSpans(float *value, float *color1, float *color2, int x, int y, int width);
+
+  /**
+   * Factor of the second color for every pixel of a span,
+   * taking the alpha of the second color into account when requested.
+   */
+  void spanMixFactors(float *factors, const float *value, const float *color2, int width);
+
  public:
   /**
    * Default constructor
@@ -84,12 +96,14 @@ class MixAddOperation : public MixBaseOperation {
  public:
   MixAddOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeSpanSampled(float *output, int x, int y, int width);
 };
 
 class MixBlendOperation : public MixBaseOperation {
  public:
   MixBlendOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeSpanSampled(float *output, int x, int y, int width);
 };
 
 class MixColorBurnOperation : public MixBaseOperation {
@@ -156,6 +170,7 @@ class MixMultiplyOperation : public MixBaseOperation {
  public:
   MixMultiplyOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeSpanSampled(float *output, int x, int y, int width);
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -186,6 +201,7 @@ class MixSubtractOperation : public MixBaseOperation {
  public:
   MixSubtractOperation();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeSpanSampled(float *output, int x, int y, int width);
 };
 
 class MixValueOperation : public MixBaseOperation {
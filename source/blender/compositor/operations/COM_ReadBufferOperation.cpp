@@ -74,6 +74,21 @@ void ReadBufferOperation::executePixelSampled(float output[4],
   }
 }
 
+void ReadBufferOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  if (m_single_value) {
+    /* write buffer has a single value stored at (0,0) */
+    for (int i = 0; i < width; i++) {
+      m_buffer->read(output + i * COM_NUM_CHANNELS_COLOR, 0, 0);
+    }
+  }
+  else {
+    for (int i = 0; i < width; i++) {
+      m_buffer->read(output + i * COM_NUM_CHANNELS_COLOR, x + i, y);
+    }
+  }
+}
+
 void ReadBufferOperation::executePixelExtend(float output[4],
                                              float x,
                                              float y,
@@ -18,6 +18,8 @@
 
 #include "COM_RenderLayersProg.h"
 
+#include "COM_BufferCache.h"
+
 #include "BKE_scene.h"
 #include "BLI_listbase.h"
 #include "DNA_scene_types.h"
@@ -66,6 +68,17 @@ void RenderLayersProg::initExecution()
   }
 }
 
+bool RenderLayersProg::hashExternalData(CacheHash *hash)
+{
+  hash->addString(this->m_passName.c_str());
+  hash->addInt(this->m_layerId);
+  if (this->m_inputBuffer) {
+    hash->add(this->m_inputBuffer,
+              sizeof(float) * this->getWidth() * this->getHeight() * this->m_elementsize);
+  }
+  return true;
+}
+
 void RenderLayersProg::doInterpolation(float output[4], float x, float y, PixelSampler sampler)
 {
   unsigned int offset;
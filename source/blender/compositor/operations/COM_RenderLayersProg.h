@@ -121,6 +121,7 @@ class RenderLayersProg : public NodeOperation {
   void initExecution();
   void deinitExecution();
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  bool hashExternalData(CacheHash *hash);
 };
 
 class RenderLayersAOOperation : public RenderLayersProg {
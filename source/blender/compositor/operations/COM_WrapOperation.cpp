@@ -79,6 +79,12 @@ void WrapOperation::executePixelSampled(float output[4], float x, float y, Pixel
   executePixelExtend(output, nx, ny, sampler, extend_x, extend_y);
 }
 
+void WrapOperation::executeSpanSampled(float *output, int x, int y, int width)
+{
+  /* Wrapping is done per pixel, don't use the span reading of the buffer. */
+  NodeOperation::executeSpanSampled(output, x, y, width);
+}
+
 bool WrapOperation::determineDependingAreaOfInterest(rcti *input,
                                                      ReadBufferOperation *readOperation,
                                                      rcti *output)
@@ -30,6 +30,7 @@ class WrapOperation : public ReadBufferOperation {
                                         ReadBufferOperation *readOperation,
                                         rcti *output);
   void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+  void executeSpanSampled(float *output, int x, int y, int width);
 
   void setWrapping(int wrapping_type);
   float getWrappedOriginalXPos(float x);
@@ -21,6 +21,8 @@
 #include "COM_defines.h"
 #include <stdio.h>
 
+#include "BLI_math_base.h"
+
 WriteBufferOperation::WriteBufferOperation(DataType datatype) : NodeOperation()
 {
   this->addInputSocket(datatype);
@@ -59,9 +61,12 @@ void WriteBufferOperation::deinitExecution()
 void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/)
 {
   MemoryBuffer *memoryBuffer = this->m_memoryProxy->getBuffer();
-  float *buffer = memoryBuffer->getBuffer();
   const int num_channels = memoryBuffer->get_num_channels();
-  if (this->m_input->isComplex()) {
+  if (memoryBuffer->isHalfFloat()) {
+    executeRegionHalf(memoryBuffer, rect);
+  }
+  else if (this->m_input->isComplex()) {
+    float *buffer = memoryBuffer->getBuffer();
     void *data = this->m_input->initializeTileData(rect);
     int x1 = rect->xmin;
     int y1 = rect->ymin;
@@ -91,14 +96,29 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
     int x2 = rect->xmax;
     int y2 = rect->ymax;
 
+    /* Calculate the input in spans, color buffers can be written to directly,
+     * others are compacted from the float[4] per pixel span layout. */
+    float *buffer = memoryBuffer->getBuffer();
+    float span[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
     int x;
     int y;
     bool breaked = false;
     for (y = y1; y < y2 && (!breaked); y++) {
-      int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-      for (x = x1; x < x2; x++) {
-        this->m_input->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-        offset4 += num_channels;
+      int offset = (y * memoryBuffer->getWidth() + x1) * num_channels;
+      for (x = x1; x < x2; x += COM_SPAN_MAX_WIDTH) {
+        const int span_width = min_ii(COM_SPAN_MAX_WIDTH, x2 - x);
+        if (num_channels == COM_NUM_CHANNELS_COLOR) {
+          this->m_input->readSpanSampled(&(buffer[offset]), x, y, span_width);
+        }
+        else {
+          this->m_input->readSpanSampled(span, x, y, span_width);
+          for (int i = 0; i < span_width; i++) {
+            memcpy(&(buffer[offset + i * num_channels]),
+                   &span[i * COM_NUM_CHANNELS_COLOR],
+                   sizeof(float) * num_channels);
+          }
+        }
+        offset += span_width * num_channels;
       }
       if (isBraked()) {
         breaked = true;
@@ -108,6 +128,39 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
   memoryBuffer->setCreatedState();
 }
 
+void WriteBufferOperation::executeRegionHalf(MemoryBuffer *memoryBuffer, rcti *rect)
+{
+  /* Half float buffers are converted from float[4] pixels, calculated per pixel for
+   * complex inputs and per span otherwise. */
+  float span[COM_SPAN_MAX_WIDTH * COM_NUM_CHANNELS_COLOR];
+  void *data = NULL;
+  if (this->m_input->isComplex()) {
+    data = this->m_input->initializeTileData(rect);
+  }
+
+  for (int y = rect->ymin; y < rect->ymax; y++) {
+    for (int x = rect->xmin; x < rect->xmax; x += COM_SPAN_MAX_WIDTH) {
+      const int span_width = min_ii(COM_SPAN_MAX_WIDTH, rect->xmax - x);
+      if (this->m_input->isComplex()) {
+        for (int i = 0; i < span_width; i++) {
+          this->m_input->read(&span[i * COM_NUM_CHANNELS_COLOR], x + i, y, data);
+        }
+      }
+      else {
+        this->m_input->readSpanSampled(span, x, y, span_width);
+      }
+      memoryBuffer->writeSpan(x, y, span_width, span);
+    }
+    if (isBraked()) {
+      break;
+    }
+  }
+
+  if (data) {
+    this->m_input->deinitializeTileData(rect, data);
+  }
+}
+
 void WriteBufferOperation::executeOpenCLRegion(OpenCLDevice *device,
                                                rcti * /*rect*/,
                                                unsigned int /*chunkNumber*/,
@@ -61,4 +61,7 @@ class WriteBufferOperation : public NodeOperation {
   {
     return m_input;
   }
+
+ private:
+  void executeRegionHalf(MemoryBuffer *memoryBuffer, rcti *rect);
 };
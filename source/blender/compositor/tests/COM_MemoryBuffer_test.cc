@@ -0,0 +1,90 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "COM_MemoryBuffer.h"
+
+static unsigned int float_bits(float value)
+{
+  unsigned int bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+TEST(compositor_half, FloatToHalf)
+{
+  EXPECT_EQ(com_float_to_half(0.0f), 0x0000);
+  EXPECT_EQ(com_float_to_half(-0.0f), 0x8000);
+  EXPECT_EQ(com_float_to_half(1.0f), 0x3c00);
+  EXPECT_EQ(com_float_to_half(-2.0f), 0xc000);
+  EXPECT_EQ(com_float_to_half(0.5f), 0x3800);
+  EXPECT_EQ(com_float_to_half(65504.0f), 0x7bff);
+  EXPECT_EQ(com_float_to_half(6.103515625e-05f), 0x0400);
+}
+
+TEST(compositor_half, FloatToHalfRounding)
+{
+  /* Halfway cases round to the nearest even mantissa. */
+  EXPECT_EQ(com_float_to_half(1.0f + ldexpf(1.0f, -11)), 0x3c00);
+  EXPECT_EQ(com_float_to_half(1.0f + 3.0f * ldexpf(1.0f, -11)), 0x3c02);
+  EXPECT_EQ(com_float_to_half(1.0f + ldexpf(1.0f, -11) + ldexpf(1.0f, -20)), 0x3c01);
+  /* Rounding up out of the largest exponent gives infinity. */
+  EXPECT_EQ(com_float_to_half(65519.0f), 0x7bff);
+  EXPECT_EQ(com_float_to_half(65520.0f), 0x7c00);
+}
+
+TEST(compositor_half, FloatToHalfDenormal)
+{
+  EXPECT_EQ(com_float_to_half(ldexpf(1.0f, -24)), 0x0001);
+  EXPECT_EQ(com_float_to_half(-ldexpf(1.0f, -24)), 0x8001);
+  EXPECT_EQ(com_float_to_half(ldexpf(1.0f, -25)), 0x0000);
+  EXPECT_EQ(com_float_to_half(ldexpf(1.5f, -25)), 0x0001);
+  EXPECT_EQ(com_float_to_half(ldexpf(3.0f, -25)), 0x0002);
+  EXPECT_EQ(com_float_to_half(ldexpf(1023.0f, -24)), 0x03ff);
+  EXPECT_EQ(com_float_to_half(ldexpf(1.0f, -30)), 0x0000);
+}
+
+TEST(compositor_half, FloatToHalfSpecial)
+{
+  const float inf = std::numeric_limits<float>::infinity();
+  EXPECT_EQ(com_float_to_half(inf), 0x7c00);
+  EXPECT_EQ(com_float_to_half(-inf), 0xfc00);
+  EXPECT_EQ(com_float_to_half(1e10f), 0x7c00);
+  EXPECT_EQ(com_float_to_half(-1e10f), 0xfc00);
+
+  const unsigned short nan = com_float_to_half(std::numeric_limits<float>::quiet_NaN());
+  EXPECT_EQ(nan & 0x7c00, 0x7c00);
+  EXPECT_NE(nan & 0x03ff, 0);
+}
+
+TEST(compositor_half, HalfToFloat)
+{
+  EXPECT_EQ(float_bits(com_half_to_float(0x0000)), float_bits(0.0f));
+  EXPECT_EQ(float_bits(com_half_to_float(0x8000)), float_bits(-0.0f));
+  EXPECT_EQ(com_half_to_float(0x3c00), 1.0f);
+  EXPECT_EQ(com_half_to_float(0xc000), -2.0f);
+  EXPECT_EQ(com_half_to_float(0x7bff), 65504.0f);
+  EXPECT_EQ(com_half_to_float(0x0001), ldexpf(1.0f, -24));
+  EXPECT_EQ(com_half_to_float(0x03ff), ldexpf(1023.0f, -24));
+  EXPECT_EQ(com_half_to_float(0x7c00), std::numeric_limits<float>::infinity());
+  EXPECT_EQ(com_half_to_float(0xfc00), -std::numeric_limits<float>::infinity());
+  EXPECT_TRUE(std::isnan(com_half_to_float(0x7e00)));
+}
+
+TEST(compositor_half, RoundTrip)
+{
+  /* Every half value converts to a float and back unchanged. */
+  for (unsigned int i = 0; i <= 0xffff; i++) {
+    const unsigned short value = (unsigned short)i;
+    const float f = com_half_to_float(value);
+    if (std::isnan(f)) {
+      EXPECT_EQ(value & 0x7c00, 0x7c00);
+      continue;
+    }
+    EXPECT_EQ(com_float_to_half(f), value);
+  }
+}
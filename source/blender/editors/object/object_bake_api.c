@@ -836,7 +836,7 @@ static int bake(Render *re,
     for (int i = 0; i < bake_images.size; i++) {
       bake_images.data[i].width = width;
       bake_images.data[i].height = height;
-      bake_images.data[i].offset = (is_split_materials ? num_pixels : 0);
+      bake_images.data[i].offset = (is_split_materials ? (size_t)i * width * height : 0);
       bake_images.data[i].image = NULL;
     }
 
@@ -1007,23 +1007,29 @@ static int bake(Render *re,
       goto cleanup;
     }
 
-    /* the baking itself */
+    /* the baking itself, all high poly objects are baked at once */
+    Object **highpoly_objects = MEM_mallocN(sizeof(Object *) * tot_highpoly,
+                                            "bake high poly object list");
     for (i = 0; i < tot_highpoly; i++) {
-      ok = RE_bake_engine(re,
-                          depsgraph,
-                          highpoly[i].ob,
-                          i,
-                          pixel_array_high,
-                          &bake_images,
-                          depth,
-                          pass_type,
-                          pass_filter,
-                          result);
-      if (!ok) {
-        BKE_reportf(
-            reports, RPT_ERROR, "Error baking from object \"%s\"", highpoly[i].ob->id.name + 2);
-        goto cleanup;
-      }
+      highpoly_objects[i] = highpoly[i].ob;
+    }
+
+    ok = RE_bake_engine(re,
+                        depsgraph,
+                        highpoly_objects,
+                        tot_highpoly,
+                        pixel_array_high,
+                        &bake_images,
+                        depth,
+                        pass_type,
+                        pass_filter,
+                        result);
+
+    MEM_freeN(highpoly_objects);
+
+    if (!ok) {
+      BKE_report(reports, RPT_ERROR, "Error baking from selected objects");
+      goto cleanup;
     }
   }
   else {
@@ -1033,8 +1039,8 @@ static int bake(Render *re,
     if (RE_bake_has_engine(re)) {
       ok = RE_bake_engine(re,
                           depsgraph,
-                          ob_low_eval,
-                          0,
+                          &ob_low_eval,
+                          1,
                           pixel_array_low,
                           &bake_images,
                           depth,
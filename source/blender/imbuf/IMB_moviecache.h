@@ -45,6 +45,8 @@ typedef void (*MovieCachePriorityDeleterFP)(void *priority_data);
 
 void IMB_moviecache_init(void);
 void IMB_moviecache_destruct(void);
+size_t IMB_moviecache_get_memory_in_use(void);
+void IMB_moviecache_enforce_limits(void);
 
 struct MovieCache *IMB_moviecache_create(const char *name,
                                          int keysize,
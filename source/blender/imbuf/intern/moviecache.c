@@ -259,6 +259,30 @@ void IMB_moviecache_destruct(void)
   }
 }
 
+/* Memory used by all movie caches, used by caches which share memory limit with them. */
+size_t IMB_moviecache_get_memory_in_use(void)
+{
+  size_t mem_in_use = 0;
+
+  if (limitor) {
+    BLI_mutex_lock(&limitor_lock);
+    mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor);
+    BLI_mutex_unlock(&limitor_lock);
+  }
+
+  return mem_in_use;
+}
+
+/* Free least priority items of movie caches when memory used by external caches grew. */
+void IMB_moviecache_enforce_limits(void)
+{
+  if (limitor) {
+    BLI_mutex_lock(&limitor_lock);
+    MEM_CacheLimiter_enforce_limits(limitor);
+    BLI_mutex_unlock(&limitor_lock);
+  }
+}
+
 MovieCache *IMB_moviecache_create(const char *name,
                                   int keysize,
                                   GHashHashFP hashfp,
@@ -375,7 +399,8 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
   mem_limit = MEM_CacheLimiter_get_maximum();
 
   BLI_mutex_lock(&limitor_lock);
-  mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor);
+  mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor) +
+               MEM_CacheLimiter_get_external_memory();
 
   if (mem_in_use + elem_size <= mem_limit) {
     do_moviecache_put(cache, userkey, ibuf, false);
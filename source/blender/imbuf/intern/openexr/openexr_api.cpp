@@ -615,6 +615,8 @@ int imb_save_openexr(struct ImBuf *ibuf, const char *name, int flags)
  */
 
 static ListBase exrhandles = {NULL, NULL};
+/* Files are read and written from multiple threads, in batch compositing for example. */
+static ThreadMutex exrhandles_mutex = BLI_MUTEX_INITIALIZER;
 
 typedef struct ExrHandle {
   struct ExrHandle *next, *prev;
@@ -678,7 +680,8 @@ typedef struct ExrLayer {
 
 /* ********************** */
 
-void *IMB_exr_get_handle(void)
+/* Caller must hold exrhandles_mutex. */
+static ExrHandle *exr_handle_new(void)
 {
   ExrHandle *data = (ExrHandle *)MEM_callocN(sizeof(ExrHandle), "exr handle");
   data->multiView = new StringVector();
@@ -687,14 +690,24 @@ void *IMB_exr_get_handle(void)
   return data;
 }
 
+void *IMB_exr_get_handle(void)
+{
+  BLI_mutex_lock(&exrhandles_mutex);
+  ExrHandle *data = exr_handle_new();
+  BLI_mutex_unlock(&exrhandles_mutex);
+  return data;
+}
+
 void *IMB_exr_get_handle_name(const char *name)
 {
+  BLI_mutex_lock(&exrhandles_mutex);
   ExrHandle *data = (ExrHandle *)BLI_rfindstring(&exrhandles, name, offsetof(ExrHandle, name));
 
   if (data == NULL) {
-    data = (ExrHandle *)IMB_exr_get_handle();
+    data = exr_handle_new();
     BLI_strncpy(data->name, name, strlen(name) + 1);
   }
+  BLI_mutex_unlock(&exrhandles_mutex);
   return data;
 }
 
@@ -1364,7 +1377,9 @@ void IMB_exr_close(void *handle)
   }
   BLI_freelistN(&data->layers);
 
+  BLI_mutex_lock(&exrhandles_mutex);
   BLI_remlink(&exrhandles, data);
+  BLI_mutex_unlock(&exrhandles_mutex);
   MEM_freeN(data);
 }
 
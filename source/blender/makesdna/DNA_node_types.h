@@ -518,6 +518,7 @@ typedef struct bNodeTree {
 
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
+#define NTREE_COM_HALF_BUFFERS (1 << 6) /* store value and vector buffers as half float */
 
 /* ntree->update */
 typedef enum eNodeTreeUpdate {
@@ -410,6 +410,13 @@ static PointerRNA rna_RenderEngine_camera_override_get(PointerRNA *ptr)
   }
 }
 
+static void rna_RenderEngine_bake_objects_begin(CollectionPropertyIterator *iter, PointerRNA *ptr)
+{
+  RenderEngine *engine = (RenderEngine *)ptr->data;
+  rna_iterator_array_begin(
+      iter, (void *)engine->bake.objects, sizeof(Object *), engine->bake.num_objects, 0, NULL);
+}
+
 static void rna_RenderEngine_engine_frame_set(RenderEngine *engine, int frame, float subframe)
 {
 #  ifdef WITH_PYTHON
@@ -773,6 +780,22 @@ static void rna_def_render_engine(BlenderRNA *brna)
   RNA_def_property_pointer_funcs(prop, "rna_RenderEngine_camera_override_get", NULL, NULL, NULL);
   RNA_def_property_struct_type(prop, "Object");
 
+  prop = RNA_def_property(srna, "bake_objects", PROP_COLLECTION, PROP_NONE);
+  RNA_def_property_struct_type(prop, "Object");
+  RNA_def_property_collection_funcs(prop,
+                                    "rna_RenderEngine_bake_objects_begin",
+                                    "rna_iterator_array_next",
+                                    "rna_iterator_array_end",
+                                    "rna_iterator_array_dereference_get",
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL);
+  RNA_def_property_ui_text(
+      prop,
+      "Bake Objects",
+      "Objects being baked, indexed by the object ID in the bake primitive pass");
+
   prop = RNA_def_property(srna, "layer_override", PROP_BOOLEAN, PROP_LAYER_MEMBER);
   RNA_def_property_boolean_sdna(prop, NULL, "layer_override", 1);
   RNA_def_property_array(prop, 20);
@@ -878,6 +901,14 @@ static void rna_def_render_engine(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_REGISTER_OPTIONAL);
   RNA_def_property_ui_text(prop, "Use Stereo Viewport", "Support rendering stereo 3D viewport");
 
+  prop = RNA_def_property(srna, "bl_use_bake_multi_object", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "type->flag", RE_USE_BAKE_MULTI_OBJECT);
+  RNA_def_property_flag(prop, PROP_REGISTER_OPTIONAL);
+  RNA_def_property_ui_text(prop,
+                           "Use Bake Multi Object",
+                           "Bake all objects and images in a single call of the bake method, "
+                           "instead of once for every object and image");
+
   RNA_define_verify_sdna(1);
 }
 
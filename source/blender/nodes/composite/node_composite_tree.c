@@ -92,6 +92,10 @@ static void free_cache(bNodeTree *ntree)
   for (node = ntree->nodes.first; node; node = node->next) {
     free_node_cache(ntree, node);
   }
+
+#ifdef WITH_COMPOSITOR
+  COM_clearCaches();
+#endif
 }
 
 /* local tree then owns all compbufs */
@@ -254,6 +258,21 @@ void ntreeCompositExecTree(Scene *scene,
   UNUSED_VARS(do_preview);
 }
 
+void ntreeCompositExecFrame(Scene *scene,
+                            bNodeTree *ntree,
+                            RenderData *rd,
+                            struct Render *re,
+                            const ColorManagedViewSettings *view_settings,
+                            const ColorManagedDisplaySettings *display_settings,
+                            const char *view_name)
+{
+#ifdef WITH_COMPOSITOR
+  COM_execute_frame(rd, scene, ntree, re, view_settings, display_settings, view_name);
+#else
+  UNUSED_VARS(scene, ntree, rd, re, view_settings, display_settings, view_name);
+#endif
+}
+
 /* *********************************************** */
 
 /* Update the outputs of the render layer nodes.
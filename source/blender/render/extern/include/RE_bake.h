@@ -67,8 +67,8 @@ bool RE_bake_has_engine(struct Render *re);
 
 bool RE_bake_engine(struct Render *re,
                     struct Depsgraph *depsgraph,
-                    struct Object *object,
-                    const int object_id,
+                    struct Object *objects[],
+                    const int num_objects,
                     const BakePixel pixel_array[],
                     const BakeImages *bake_images,
                     const int depth,
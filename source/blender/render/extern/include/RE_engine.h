@@ -64,6 +64,7 @@ extern "C" {
 #define RE_USE_SPHERICAL_STEREO 128
 #define RE_USE_STEREO_VIEWPORT 256
 #define RE_USE_GPU_CONTEXT 512
+#define RE_USE_BAKE_MULTI_OBJECT 1024
 
 /* RenderEngine.flag */
 #define RE_ENGINE_ANIMATION 1
@@ -143,7 +144,12 @@ typedef struct RenderEngine {
   struct {
     const struct BakePixel *pixels;
     float *result;
+    size_t num_pixels;
     int width, height, depth;
+    /* Objects being baked, indexed by the object_id of the pixels. */
+    struct Object **objects;
+    int num_objects;
+    /* Only bake pixels of this object, or pixels of all objects when -1. */
     int object_id;
   } bake;
 
@@ -292,6 +292,8 @@ void RE_RenderAnim(struct Render *re,
                    int sfra,
                    int efra,
                    int tfra);
+void RE_CompositeAnim(
+    struct Render *re, struct Main *bmain, struct Scene *scene, int sfra, int efra, int tfra);
 #ifdef WITH_FREESTYLE
 void RE_RenderFreestyleStrokes(struct Render *re,
                                struct Main *bmain,
@@ -31,6 +31,7 @@
 
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_math_base.h"
 #include "BLI_math_bits.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
@@ -155,6 +156,17 @@ void RE_engine_free(RenderEngine *engine)
 
 /* Bake Render Results */
 
+/* Number of pixels in a row of a tile that are part of the bake pixel array, the last row of
+ * the bake image may only be partially filled. */
+static int bake_row_num_pixels(const RenderEngine *engine, size_t bake_offset, int w)
+{
+  if (bake_offset >= engine->bake.num_pixels) {
+    return 0;
+  }
+
+  return (int)min_zz((size_t)w, engine->bake.num_pixels - bake_offset);
+}
+
 static RenderResult *render_result_from_bake(RenderEngine *engine, int x, int y, int w, int h)
 {
   /* Create render result with specified size. */
@@ -186,10 +198,13 @@ static RenderResult *render_result_from_bake(RenderEngine *engine, int x, int y,
     float *differential = differential_pass->rect + offset;
 
     size_t bake_offset = (y + ty) * engine->bake.width + x;
+    const int num_pixels = bake_row_num_pixels(engine, bake_offset, w);
     const BakePixel *bake_pixel = engine->bake.pixels + bake_offset;
 
     for (int tx = 0; tx < w; tx++) {
-      if (bake_pixel->object_id != engine->bake.object_id) {
+      if (tx >= num_pixels || bake_pixel->object_id < 0 ||
+          bake_pixel->object_id >= engine->bake.num_objects ||
+          (engine->bake.object_id != -1 && bake_pixel->object_id != engine->bake.object_id)) {
         primitive[0] = int_as_float(-1);
         primitive[1] = int_as_float(-1);
       }
@@ -214,10 +229,13 @@ static RenderResult *render_result_from_bake(RenderEngine *engine, int x, int y,
   /* Initialize tile render result from full image bake result. */
   for (int ty = 0; ty < h; ty++) {
     size_t offset = ty * w * engine->bake.depth;
-    size_t bake_offset = ((y + ty) * engine->bake.width + x) * engine->bake.depth;
-    size_t size = w * engine->bake.depth * sizeof(float);
+    size_t bake_offset = (y + ty) * engine->bake.width + x;
+    size_t size = bake_row_num_pixels(engine, bake_offset, w) * engine->bake.depth *
+                  sizeof(float);
 
-    memcpy(result_pass->rect + offset, engine->bake.result + bake_offset, size);
+    memcpy(result_pass->rect + offset,
+           engine->bake.result + bake_offset * engine->bake.depth,
+           size);
   }
 
   return rr;
@@ -239,10 +257,11 @@ static void render_result_to_bake(RenderEngine *engine, RenderResult *rr)
 
   for (int ty = 0; ty < h; ty++) {
     size_t offset = ty * w * engine->bake.depth;
-    size_t bake_offset = ((y + ty) * engine->bake.width + x) * engine->bake.depth;
-    size_t size = w * engine->bake.depth * sizeof(float);
+    size_t bake_offset = (y + ty) * engine->bake.width + x;
+    size_t size = bake_row_num_pixels(engine, bake_offset, w) * engine->bake.depth *
+                  sizeof(float);
 
-    memcpy(engine->bake.result + bake_offset, rpass->rect + offset, size);
+    memcpy(engine->bake.result + bake_offset * engine->bake.depth, rpass->rect + offset, size);
   }
 }
 
@@ -656,10 +675,40 @@ bool RE_bake_has_engine(Render *re)
   return (type->bake != NULL);
 }
 
+static void engine_bake_pixels(RenderEngine *engine,
+                               RenderEngineType *type,
+                               Object *objects[],
+                               const int num_objects,
+                               const int object_id,
+                               const BakePixel pixels[],
+                               float result[],
+                               const size_t num_pixels,
+                               const int width,
+                               const int height,
+                               const int depth,
+                               const eScenePassType pass_type,
+                               const int pass_filter)
+{
+  engine->bake.pixels = pixels;
+  engine->bake.result = result;
+  engine->bake.num_pixels = num_pixels;
+  engine->bake.width = width;
+  engine->bake.height = height;
+  engine->bake.depth = depth;
+  engine->bake.objects = objects;
+  engine->bake.num_objects = num_objects;
+  engine->bake.object_id = object_id;
+
+  Object *object = objects[(object_id != -1) ? object_id : 0];
+  type->bake(engine, engine->depsgraph, object, pass_type, pass_filter, width, height);
+
+  memset(&engine->bake, 0, sizeof(engine->bake));
+}
+
 bool RE_bake_engine(Render *re,
                     Depsgraph *depsgraph,
-                    Object *object,
-                    const int object_id,
+                    Object *objects[],
+                    const int num_objects,
                     const BakePixel pixel_array[],
                     const BakeImages *bake_images,
                     const int depth,
@@ -706,20 +755,59 @@ bool RE_bake_engine(Render *re,
       type->update(engine, re->main, engine->depsgraph);
     }
 
-    for (int i = 0; i < bake_images->size; i++) {
-      const BakeImage *image = bake_images->data + i;
-
-      engine->bake.pixels = pixel_array + image->offset;
-      engine->bake.result = result + image->offset * depth;
-      engine->bake.width = image->width;
-      engine->bake.height = image->height;
-      engine->bake.depth = depth;
-      engine->bake.object_id = object_id;
-
-      type->bake(
-          engine, engine->depsgraph, object, pass_type, pass_filter, image->width, image->height);
+    if (type->flag & RE_USE_BAKE_MULTI_OBJECT) {
+      /* Bake the pixels of all images and objects in a single pass, instead of syncing the
+       * scene and launching the bake for every image and object. The pixel arrays of the images
+       * follow each other, so they are passed to the engine as one image with rows as wide as
+       * the widest image. Images may share pixels, which are then baked only once. */
+      size_t num_pixels = 0;
+      int width = 1;
+
+      for (int i = 0; i < bake_images->size; i++) {
+        const BakeImage *image = bake_images->data + i;
+        num_pixels = max_zz(num_pixels, image->offset + (size_t)image->width * image->height);
+        width = max_ii(width, image->width);
+      }
 
-      memset(&engine->bake, 0, sizeof(engine->bake));
+      if (num_pixels > 0) {
+        const int height = (int)((num_pixels + width - 1) / width);
+
+        engine_bake_pixels(engine,
+                           type,
+                           objects,
+                           num_objects,
+                           -1,
+                           pixel_array,
+                           result,
+                           num_pixels,
+                           width,
+                           height,
+                           depth,
+                           pass_type,
+                           pass_filter);
+      }
+    }
+    else {
+      /* Engines that don't support it get a call for every object and image. */
+      for (int object_id = 0; object_id < num_objects; object_id++) {
+        for (int i = 0; i < bake_images->size; i++) {
+          const BakeImage *image = bake_images->data + i;
+
+          engine_bake_pixels(engine,
+                             type,
+                             objects,
+                             num_objects,
+                             object_id,
+                             pixel_array + image->offset,
+                             result + image->offset * depth,
+                             (size_t)image->width * image->height,
+                             image->width,
+                             image->height,
+                             depth,
+                             pass_type,
+                             pass_filter);
+        }
+      }
     }
 
     engine->depsgraph = NULL;
@@ -84,6 +84,8 @@
 #include "IMB_metadata.h"
 #include "PIL_time.h"
 
+#include "atomic_ops.h"
+
 #include "RE_engine.h"
 #include "RE_pipeline.h"
 #include "RE_render_ext.h"
@@ -2665,6 +2667,302 @@ void RE_RenderAnim(Render *re,
   G.is_rendering = false;
 }
 
+/* ************** Batch Compositing ************* */
+
+/* Compositing without render layers only depends on the node tree and the frame number,
+ * so frames can be composited at the same time. Every slot owns a render receiving the
+ * result of the composite node, frames are handed out to the slots in order. */
+
+#define COMPOSITE_ANIM_MAX_SLOTS 4
+
+typedef struct CompositeAnimData {
+  Render *re;
+  Main *bmain;
+  Scene *scene;
+  int sfra, tfra, totframe;
+
+  /* Index of the next frame to composite, shared by all slots. */
+  int next_frame;
+  /* Localizing flushes the active output back to the original tree. */
+  ThreadMutex localize_mutex;
+
+  int totrendered, totskipped;
+  bool is_error;
+} CompositeAnimData;
+
+typedef struct CompositeAnimSlot {
+  CompositeAnimData *data;
+  Render *re;
+} CompositeAnimSlot;
+
+/* Multilayer image sequences keep a single frame's render result on the image and free it
+ * whenever another frame is requested, so they can't be read from several frames at once. */
+static bool node_tree_has_multilayer_sequence(bNodeTree *ntree)
+{
+  bNode *node;
+
+  for (node = ntree->nodes.first; node; node = node->next) {
+    if (node->type == CMP_NODE_IMAGE && node->id) {
+      Image *ima = (Image *)node->id;
+      if (ima->type == IMA_TYPE_MULTILAYER && ima->source == IMA_SRC_SEQUENCE) {
+        return true;
+      }
+    }
+    if (ELEM(node->type, NODE_GROUP, NODE_CUSTOM_GROUP)) {
+      if (node->id) {
+        if (node_tree_has_multilayer_sequence((bNodeTree *)node->id)) {
+          return true;
+        }
+      }
+    }
+  }
+
+  return false;
+}
+
+static bool composite_anim_supported(Scene *scene)
+{
+  if (composite_needs_render(scene, 0)) {
+    return false;
+  }
+  if (RE_seq_render_active(scene, &scene->r)) {
+    return false;
+  }
+  /* Movie frames have to be written in order. */
+  return !BKE_imtype_is_movie(scene->r.im_format.imtype);
+}
+
+static void composite_anim_stats_nothing(void *UNUSED(arg), const char *UNUSED(str))
+{
+}
+
+static bool composite_anim_frame_skip(CompositeAnimData *data, const RenderData *rd, int frame)
+{
+  char name[FILE_MAX];
+
+  if ((rd->mode & R_NO_OVERWRITE) == 0) {
+    return false;
+  }
+
+  BKE_image_path_from_imformat(name,
+                               rd->pic,
+                               BKE_main_blendfile_path(data->bmain),
+                               frame,
+                               &rd->im_format,
+                               (rd->scemode & R_EXTENSION) != 0,
+                               true,
+                               NULL);
+
+  if ((rd->scemode & R_MULTIVIEW) != 0 && rd->im_format.views_format == R_IMF_VIEWS_INDIVIDUAL) {
+    char filepath[FILE_MAX];
+    bool is_skip = false;
+
+    LISTBASE_FOREACH (SceneRenderView *, srv, &rd->views) {
+      if (!BKE_scene_multiview_is_render_view_active(rd, srv)) {
+        continue;
+      }
+      BKE_scene_multiview_filepath_get(srv, name, filepath);
+      if (BLI_exists(filepath)) {
+        printf("skipping existing frame \"%s\" for view \"%s\"\n", filepath, srv->name);
+        is_skip = true;
+      }
+    }
+    return is_skip;
+  }
+
+  if (BLI_exists(name)) {
+    printf("skipping existing frame \"%s\"\n", name);
+    return true;
+  }
+  return false;
+}
+
+static bool composite_anim_frame(CompositeAnimSlot *slot, int frame)
+{
+  CompositeAnimData *data = slot->data;
+  Render *re = slot->re;
+  Scene *scene = data->scene;
+  char name[FILE_MAX];
+  RenderResult rres;
+  bNodeTree *ntree;
+  bool ok;
+
+  re->r.cfra = frame;
+  re->i.cfra = frame;
+  re->i.starttime = PIL_check_seconds_timer();
+
+  BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
+  render_result_free(re->result);
+  if ((re->r.mode & R_CROP) == 0) {
+    render_result_disprect_to_full_resolution(re);
+  }
+  re->result = render_result_new(re, &re->disprect, 0, RR_USE_MEM, RR_ALL_LAYERS, RR_ALL_VIEWS);
+  BLI_rw_mutex_unlock(&re->resultmutex);
+
+  /* Only the animation of the node tree itself is evaluated, drivers need the depsgraph. */
+  BLI_mutex_lock(&data->localize_mutex);
+  ntree = ntreeLocalize(scene->nodetree);
+  if (scene->nodetree->adt) {
+    const AnimationEvalContext anim_eval_context = BKE_animsys_eval_context_construct(
+        NULL, BKE_scene_frame_to_ctime(scene, frame));
+    BKE_animsys_evaluate_animdata(
+        &ntree->id, scene->nodetree->adt, &anim_eval_context, ADT_RECALC_ANIM, false);
+  }
+  BLI_mutex_unlock(&data->localize_mutex);
+
+  /* The compositor reports progress unconditionally. */
+  ntree->stats_draw = composite_anim_stats_nothing;
+  ntree->progress = float_nothing;
+  ntree->test_break = re->test_break;
+  ntree->sdh = ntree->prh = NULL;
+  ntree->tbh = re->tbh;
+
+  LISTBASE_FOREACH (RenderView *, rv, &re->result->views) {
+    ntreeCompositExecFrame(scene,
+                           ntree,
+                           &re->r,
+                           re,
+                           &scene->view_settings,
+                           &scene->display_settings,
+                           rv->name);
+  }
+
+  ntreeFreeLocalTree(ntree);
+  MEM_freeN(ntree);
+
+  if (re->test_break(re->tbh)) {
+    return false;
+  }
+
+  BKE_image_path_from_imformat(name,
+                               re->r.pic,
+                               BKE_main_blendfile_path(data->bmain),
+                               frame,
+                               &re->r.im_format,
+                               (re->r.scemode & R_EXTENSION) != 0,
+                               true,
+                               NULL);
+
+  RE_AcquireResultImageViews(re, &rres);
+  ok = RE_WriteRenderViewsImage(NULL, &rres, scene, false, name);
+  RE_ReleaseResultImageViews(re, &rres);
+
+  BLI_timecode_string_from_time_simple(
+      name, sizeof(name), PIL_check_seconds_timer() - re->i.starttime);
+  printf("Fra:%d Composite Time: %s\n", frame, name);
+  fflush(stdout);
+
+  return ok;
+}
+
+static void *do_composite_anim_thread(void *slot_v)
+{
+  CompositeAnimSlot *slot = (CompositeAnimSlot *)slot_v;
+  CompositeAnimData *data = slot->data;
+
+  while (!data->is_error && !data->re->test_break(data->re->tbh)) {
+    const int index = atomic_fetch_and_add_int32(&data->next_frame, 1);
+    if (index >= data->totframe) {
+      break;
+    }
+
+    const int frame = data->sfra + index * data->tfra;
+    if (composite_anim_frame_skip(data, &slot->re->r, frame)) {
+      atomic_add_and_fetch_int32(&data->totskipped, 1);
+      continue;
+    }
+
+    if (!composite_anim_frame(slot, frame)) {
+      data->is_error = true;
+      break;
+    }
+    atomic_add_and_fetch_int32(&data->totrendered, 1);
+  }
+
+  return NULL;
+}
+
+/* Composites and saves the frames of a scene that has no render layers in its compositor,
+ * executing several frames at the same time. Falls back to RE_RenderAnim otherwise. */
+void RE_CompositeAnim(Render *re, Main *bmain, Scene *scene, int sfra, int efra, int tfra)
+{
+  CompositeAnimSlot slots[COMPOSITE_ANIM_MAX_SLOTS];
+  CompositeAnimData data = {NULL};
+  ListBase threads;
+  int totslot, i;
+
+  if (!composite_anim_supported(scene)) {
+    printf("Compositing frames separately needs a scene without render layers in the "
+           "compositor, without sequencer strips and with an image output format, "
+           "rendering the animation instead\n");
+    RE_RenderAnim(re, bmain, scene, NULL, NULL, sfra, efra, tfra);
+    return;
+  }
+
+  render_callback_exec_id(re, bmain, &scene->id, BKE_CB_EVT_RENDER_INIT);
+
+  const RenderData rd = scene->r;
+
+  data.re = re;
+  data.bmain = bmain;
+  data.scene = scene;
+  data.sfra = sfra;
+  data.tfra = max_ii(tfra, 1);
+  data.totframe = (efra >= sfra) ? (efra - sfra) / data.tfra + 1 : 0;
+  BLI_mutex_init(&data.localize_mutex);
+
+  totslot = min_iii(COMPOSITE_ANIM_MAX_SLOTS, BLI_system_thread_count(), data.totframe);
+  totslot = max_ii(totslot, 1);
+  if (node_tree_has_multilayer_sequence(scene->nodetree)) {
+    totslot = 1;
+  }
+
+  /* Renders are created and initialized here, their results are only touched by one slot. */
+  for (i = 0; i < totslot; i++) {
+    char render_name[RE_MAXNAME];
+    BLI_snprintf(render_name, sizeof(render_name), "%s Composite %d", re->name, i);
+
+    slots[i].data = &data;
+    slots[i].re = RE_NewRender(render_name);
+    slots[i].re->test_break = re->test_break;
+    slots[i].re->tbh = re->tbh;
+
+    if (!render_init_from_main(slots[i].re, &rd, bmain, scene, NULL, NULL, 0, 1)) {
+      data.is_error = true;
+    }
+  }
+
+  G.is_rendering = true;
+
+  if (!data.is_error) {
+    BLI_threadpool_init(&threads, do_composite_anim_thread, totslot);
+    for (i = 0; i < totslot; i++) {
+      BLI_threadpool_insert(&threads, &slots[i]);
+    }
+    BLI_threadpool_end(&threads);
+  }
+
+  for (i = 0; i < totslot; i++) {
+    RE_FreeRender(slots[i].re);
+  }
+  BLI_mutex_end(&data.localize_mutex);
+
+  if (data.is_error) {
+    G.is_break = true;
+  }
+
+  if (data.totskipped && data.totrendered == 0) {
+    BKE_report(re->reports, RPT_INFO, "No frames rendered, skipped to not overwrite");
+  }
+
+  render_callback_exec_id(re,
+                          bmain,
+                          &scene->id,
+                          G.is_break ? BKE_CB_EVT_RENDER_CANCEL : BKE_CB_EVT_RENDER_COMPLETE);
+
+  G.is_rendering = false;
+}
+
 void RE_PreviewRender(Render *re, Main *bmain, Scene *sce)
 {
   Object *camera;
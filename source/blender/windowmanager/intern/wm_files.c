@@ -88,6 +88,8 @@
 #include "BKE_undo_system.h"
 #include "BKE_workspace.h"
 
+#include "COM_compositor.h"
+
 #include "BLO_readfile.h"
 #include "BLO_undofile.h" /* to save from an undo memfile */
 #include "BLO_writefile.h"
@@ -543,6 +545,11 @@ static void wm_file_read_pre(bContext *C, bool use_data, bool UNUSED(use_userdef
   if (use_data) {
     BKE_callback_exec_null(CTX_data_main(C), BKE_CB_EVT_LOAD_PRE);
     BLI_timer_on_file_load();
+
+#ifdef WITH_COMPOSITOR
+    /* Buffers of the compositor trees of the closed file are not needed anymore. */
+    COM_clearCaches();
+#endif
   }
 
   /* Always do this as both startup and preferences may have loaded in many font's
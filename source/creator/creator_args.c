@@ -519,6 +519,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   printf("Render Options:\n");
   BLI_argsPrintArgDoc(ba, "--background");
   BLI_argsPrintArgDoc(ba, "--render-anim");
+  BLI_argsPrintArgDoc(ba, "--composite-anim");
   BLI_argsPrintArgDoc(ba, "--scene");
   BLI_argsPrintArgDoc(ba, "--render-frame");
   BLI_argsPrintArgDoc(ba, "--frame-start");
@@ -1650,6 +1651,32 @@ static int arg_handle_render_animation(int UNUSED(argc), const char **UNUSED(arg
   return 0;
 }
 
+static const char arg_handle_composite_animation_doc[] =
+    "\n\t"
+    "Composite frames from start to end (inclusive), several frames at the same time.\n"
+    "\tOnly for scenes without render layers in the compositor, others are rendered as with '-a'.";
+static int arg_handle_composite_animation(int UNUSED(argc),
+                                          const char **UNUSED(argv),
+                                          void *data)
+{
+  bContext *C = data;
+  Scene *scene = CTX_data_scene(C);
+  if (scene) {
+    Main *bmain = CTX_data_main(C);
+    Render *re = RE_NewSceneRender(scene);
+    ReportList reports;
+    BKE_reports_init(&reports, RPT_STORE);
+    RE_SetReports(re, &reports);
+    RE_CompositeAnim(re, bmain, scene, scene->r.sfra, scene->r.efra, scene->r.frame_step);
+    RE_SetReports(re, NULL);
+    BKE_reports_clear(&reports);
+  }
+  else {
+    printf("\nError: no blend loaded. cannot use '--composite-anim'.\n");
+  }
+  return 0;
+}
+
 static const char arg_handle_scene_set_doc[] =
     "<name>\n"
     "\tSet the active scene <name> for rendering.";
@@ -2269,6 +2296,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   /* fourth pass: processing arguments */
   BLI_argsAdd(ba, 4, "-f", "--render-frame", CB(arg_handle_render_frame), C);
   BLI_argsAdd(ba, 4, "-a", "--render-anim", CB(arg_handle_render_animation), C);
+  BLI_argsAdd(ba, 4, NULL, "--composite-anim", CB(arg_handle_composite_animation), C);
   BLI_argsAdd(ba, 4, "-S", "--scene", CB(arg_handle_scene_set), C);
   BLI_argsAdd(ba, 4, "-s", "--frame-start", CB(arg_handle_frame_start_set), C);
   BLI_argsAdd(ba, 4, "-e", "--frame-end", CB(arg_handle_frame_end_set), C);